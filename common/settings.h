@@ -162,6 +162,18 @@ struct Settings {
   bool dump_skp_on_shader_compilation = false;
   bool cache_sksl = false;
   bool purge_persistent_cache = false;
+  // Persist the pixels of images that are expensive to decode across launches.
+  // Only supported by the Impeller image decoder.
+  bool enable_decoded_image_disk_cache = false;
+  // The budget of the process-wide cache of decoded images that are shared
+  // between identical image requests, or 0 to disable it. If unset, the shell
+  // keeps the budget the cache already has, which is 32 MiB unless another
+  // shell set it. Only supported by the Impeller image decoder.
+  std::optional<size_t> decoded_image_cache_max_bytes;
+  // The zlib compression level, from 0 to 9, of the PNG images in compressed
+  // screenshots and Skia picture screenshots. Lower levels encode faster but
+  // produce larger images.
+  int screenshot_png_zlib_level = 6;
   bool endless_trace_buffer = false;
   bool enable_dart_profiling = false;
   bool disable_dart_asserts = false;
@@ -232,6 +244,10 @@ struct Settings {
   // Force disable the android surface control even where supported.
   bool disable_surface_control = false;
 
+  // Disable offscreen MSAA when Impeller renders with Vulkan on a CPU
+  // implementation, such as SwiftShader.
+  bool disable_msaa_on_cpu_devices = false;
+
   // If true, the UI thread is the platform thread on supported
   // platforms.
   bool merged_platform_ui_thread = true;
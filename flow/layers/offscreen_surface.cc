@@ -37,7 +37,8 @@ static sk_sp<SkSurface> CreateSnapshotSurface(GrDirectContext* surface_context,
 ///
 /// If compressed is true the data is encoded as PNG.
 static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
-                                   bool compressed) {
+                                   bool compressed,
+                                   int png_zlib_level) {
   // Prepare an image from the surface, this image may potentially be on th GPU.
   auto potentially_gpu_snapshot = offscreen_surface->makeImageSnapshot();
   if (!potentially_gpu_snapshot) {
@@ -56,7 +57,9 @@ static sk_sp<SkData> GetRasterData(const sk_sp<SkSurface>& offscreen_surface,
   // If the caller want the pixels to be compressed, there is a Skia utility to
   // compress to PNG. Use that.
   if (compressed) {
-    return SkPngEncoder::Encode(nullptr, cpu_snapshot.get(), {});
+    SkPngEncoder::Options options;
+    options.fZLibLevel = png_zlib_level;
+    return SkPngEncoder::Encode(nullptr, cpu_snapshot.get(), options);
   }
 
   // Copy it into a bitmap and return the same.
@@ -76,8 +79,10 @@ OffscreenSurface::OffscreenSurface(GrDirectContext* surface_context,
   }
 }
 
-sk_sp<SkData> OffscreenSurface::GetRasterData(bool compressed) const {
-  return flutter::GetRasterData(offscreen_surface_, compressed);
+sk_sp<SkData> OffscreenSurface::GetRasterData(bool compressed,
+                                              int png_zlib_level) const {
+  return flutter::GetRasterData(offscreen_surface_, compressed,
+                                png_zlib_level);
 }
 
 DlCanvas* OffscreenSurface::GetCanvas() {
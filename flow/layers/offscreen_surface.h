@@ -28,7 +28,10 @@ class OffscreenSurface {
 
   ~OffscreenSurface() = default;
 
-  sk_sp<SkData> GetRasterData(bool compressed) const;
+  /// Returns the pixels of the surface, encoded as a PNG image with the given
+  /// zlib compression level if |compressed|. Level 6 is the default of the
+  /// PNG encoder.
+  sk_sp<SkData> GetRasterData(bool compressed, int png_zlib_level = 6) const;
 
   DlCanvas* GetCanvas();
 
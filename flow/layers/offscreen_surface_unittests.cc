@@ -41,4 +41,21 @@ TEST(OffscreenSurfaceTest, PaintSurfaceBlack) {
   ASSERT_EQ(actual[0], 0xFF000000u);
 }
 
+TEST(OffscreenSurfaceTest, CompressesWithZLibLevel) {
+  auto surface =
+      std::make_unique<OffscreenSurface>(nullptr, SkISize::Make(64, 64));
+
+  DlCanvas* canvas = surface->GetCanvas();
+  canvas->Clear(DlColor::kBlack());
+  canvas->Flush();
+
+  // Level 0 stores the pixels without deflating them.
+  auto stored = surface->GetRasterData(true, 0);
+  auto deflated = surface->GetRasterData(true, 9);
+  ASSERT_TRUE(stored);
+  ASSERT_TRUE(deflated);
+  EXPECT_GT(stored->size(), 64u * 64u);
+  EXPECT_LT(deflated->size(), stored->size());
+}
+
 }  // namespace flutter::testing
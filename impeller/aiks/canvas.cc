@@ -550,9 +550,13 @@ void Canvas::DrawCircle(const Point& center,
   AddRenderEntityToCurrentPass(std::move(entity));
 }
 
-void Canvas::ClipPath(const Path& path, Entity::ClipOperation clip_op) {
+void Canvas::ClipPath(const Path& path,
+                      Entity::ClipOperation clip_op,
+                      bool retain_tessellation) {
   auto bounds = path.GetBoundingBox();
-  ClipGeometry(Geometry::MakeFillPath(path), clip_op);
+  ClipGeometry(Geometry::MakeFillPath(path, /*inner_rect=*/std::nullopt,
+                                      retain_tessellation),
+               clip_op);
   if (clip_op == Entity::ClipOperation::kIntersect) {
     if (bounds.has_value()) {
       IntersectCulling(bounds.value());
@@ -145,9 +145,14 @@ class Canvas {
       SamplerDescriptor sampler = {},
       SourceRectConstraint src_rect_constraint = SourceRectConstraint::kFast);
 
+  /// If |retain_tessellation| is true, the path is expected to be clipped
+  /// again with the same path data in later frames, for instance because it
+  /// comes from a retained display list, and its tessellation is kept in the
+  /// |TessellationCache| of the content context.
   void ClipPath(
       const Path& path,
-      Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect);
+      Entity::ClipOperation clip_op = Entity::ClipOperation::kIntersect,
+      bool retain_tessellation = false);
 
   void ClipRect(
       const Rect& rect,
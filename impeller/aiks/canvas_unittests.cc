@@ -2,10 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <array>
+
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
 #include "impeller/aiks/aiks_context.h"
 #include "impeller/aiks/aiks_unittests.h"
 #include "impeller/aiks/experimental_canvas.h"
+#include "impeller/aiks/image_filter.h"
+#include "impeller/aiks/testing/context_spy.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
 
@@ -28,6 +34,122 @@ std::unique_ptr<ExperimentalCanvas> CreateTestCanvas(
   return std::make_unique<ExperimentalCanvas>(context, render_target, false);
 }
 
+namespace {
+
+/// An identity backdrop filter that records the inputs it wraps.
+class RecordingImageFilter final : public ImageFilter {
+ public:
+  explicit RecordingImageFilter(
+      std::shared_ptr<std::vector<FilterInput::Ref>> inputs)
+      : inputs_(std::move(inputs)) {}
+
+  std::shared_ptr<FilterContents> WrapInput(
+      const FilterInput::Ref& input) const override {
+    inputs_->push_back(input);
+    return FilterContents::MakeMatrixFilter(input, Matrix(), {});
+  }
+
+  std::shared_ptr<ImageFilter> Clone() const override {
+    return std::make_shared<RecordingImageFilter>(inputs_);
+  }
+
+  void Visit(ImageFilterVisitor& visitor) override {}
+
+ private:
+  std::shared_ptr<std::vector<FilterInput::Ref>> inputs_;
+};
+
+void DrawBackdropFilterCard(ExperimentalCanvas& canvas,
+                            Rect card,
+                            const std::shared_ptr<ImageFilter>& filter) {
+  canvas.Save(Canvas::kMaxDepth);
+  canvas.ClipRect(card);
+  canvas.SaveLayer({}, card, filter, ContentBoundsPromise::kContainsContents,
+                   Canvas::kMaxDepth, /*can_distribute_opacity=*/false);
+  canvas.Restore();
+  canvas.Restore();
+}
+
+std::shared_ptr<Texture> GetInputTexture(const FilterInput::Ref& input,
+                                         const ContentContext& context) {
+  std::optional<Snapshot> snapshot =
+      input->GetSnapshot("Backdrop", context, Entity());
+  return snapshot.has_value() ? snapshot->texture : nullptr;
+}
+
+/// Replays draws into an |ExperimentalCanvas| whose render passes record
+/// their commands instead of encoding them.
+class RecordingCanvasHarness {
+ public:
+  explicit RecordingCanvasHarness(const std::shared_ptr<Context>& real_context)
+      : spy_(ContextSpy::Make()),
+        context_(spy_->MakeContext(real_context), nullptr),
+        render_target_(context_.GetRenderTargetCache()->CreateOffscreen(
+            *context_.GetContext(),
+            {100, 100},
+            1)),
+        canvas_(context_, render_target_, /*requires_readback=*/false) {}
+
+  ExperimentalCanvas& canvas() { return canvas_; }
+
+  /// Ends the replay and returns the commands of the root pass.
+  const std::vector<Command>& EndReplay() {
+    canvas_.EndReplay();
+    FML_CHECK(!spy_->render_passes_.empty());
+    return spy_->render_passes_.front()->GetCommands();
+  }
+
+ private:
+  std::shared_ptr<ContextSpy> spy_;
+  ContentContext context_;
+  RenderTarget render_target_;
+  ExperimentalCanvas canvas_;
+};
+
+/// Reads back the pixel at |point| of an 8-bit per channel |texture|.
+std::array<uint8_t, 4> ReadPixel(const std::shared_ptr<Context>& context,
+                                 const std::shared_ptr<Texture>& texture,
+                                 IPoint point) {
+  const TextureDescriptor& desc = texture->GetTextureDescriptor();
+  std::shared_ptr<DeviceBuffer> buffer =
+      context->GetResourceAllocator()->CreateBuffer(DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kHostVisible,
+          .size = desc.GetByteSizeOfBaseMipLevel(),
+      });
+  std::shared_ptr<CommandBuffer> command_buffer =
+      context->CreateCommandBuffer();
+  std::shared_ptr<BlitPass> blit_pass = command_buffer->CreateBlitPass();
+  FML_CHECK(blit_pass->AddCopy(texture, buffer));
+  FML_CHECK(blit_pass->EncodeCommands(context->GetResourceAllocator()));
+
+  fml::AutoResetWaitableEvent latch;
+  FML_CHECK(context->GetCommandQueue()
+                ->Submit({command_buffer},
+                         [&latch](CommandBuffer::Status) { latch.Signal(); })
+                .ok());
+  latch.Wait();
+
+  std::array<uint8_t, 4> pixel;
+  const uint8_t* contents = buffer->OnGetContents() +
+                            (point.y * desc.size.width + point.x) * 4;
+  std::copy_n(contents, 4, pixel.begin());
+  return pixel;
+}
+
+/// Rects are drawn as a 4 vertex strip, batches as 6 vertices per rect.
+size_t GetVertexCount(const Command& command) {
+  return command.vertex_buffer.vertex_count;
+}
+
+/// The local space top left corner of the first rect drawn by |command|.
+Point GetFirstVertex(const Command& command) {
+  const BufferView& view = command.vertex_buffer.vertex_buffer;
+  return *reinterpret_cast<const Point*>(view.buffer->OnGetContents() +
+                                         view.range.offset);
+}
+
+}  // namespace
+
 TEST_P(AiksTest, TransformMultipliesCorrectly) {
   ContentContext context(GetContext(), nullptr);
   auto canvas = CreateTestCanvas(context);
@@ -447,6 +569,203 @@ TEST_P(AiksTest, PathClipDiffAgainstFullyCoveredCullRect) {
   ASSERT_EQ(canvas->GetCurrentLocalCullingBounds().value(), result_cull);
 }
 
+TEST_P(AiksTest, SiblingBackdropFiltersReuseBackdropTexture) {
+  ContentContext context(GetContext(), nullptr);
+  const Capabilities& capabilities = *GetContext()->GetCapabilities();
+  if (!capabilities.SupportsOffscreenMSAA() ||
+      capabilities.SupportsReadFromResolve()) {
+    GTEST_SKIP() << "The backdrop is only reused when the pass flips between "
+                    "textures.";
+  }
+  RenderTarget render_target = context.GetRenderTargetCache()->CreateOffscreen(
+      *context.GetContext(), {400, 400}, 1);
+  ExperimentalCanvas canvas(context, render_target,
+                            /*requires_readback=*/true);
+  auto inputs = std::make_shared<std::vector<FilterInput::Ref>>();
+  auto filter = std::make_shared<RecordingImageFilter>(inputs);
+
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 400, 400), {.color = Color::Red()});
+  DrawBackdropFilterCard(canvas, Rect::MakeXYWH(0, 0, 100, 100), filter);
+  DrawBackdropFilterCard(canvas, Rect::MakeXYWH(200, 0, 100, 100), filter);
+  DrawBackdropFilterCard(canvas, Rect::MakeXYWH(0, 200, 100, 100), filter);
+
+  ASSERT_EQ(inputs->size(), 3u);
+  std::shared_ptr<Texture> backdrop = GetInputTexture(inputs->at(0), context);
+  ASSERT_TRUE(backdrop);
+  EXPECT_EQ(GetInputTexture(inputs->at(1), context), backdrop);
+  EXPECT_EQ(GetInputTexture(inputs->at(2), context), backdrop);
+
+  canvas.EndReplay();
+}
+
+TEST_P(AiksTest, DrawingUnderBackdropFilterReadsBackdropAgain) {
+  ContentContext context(GetContext(), nullptr);
+  const Capabilities& capabilities = *GetContext()->GetCapabilities();
+  if (!capabilities.SupportsOffscreenMSAA() ||
+      capabilities.SupportsReadFromResolve()) {
+    GTEST_SKIP() << "The backdrop is only reused when the pass flips between "
+                    "textures.";
+  }
+  RenderTarget render_target = context.GetRenderTargetCache()->CreateOffscreen(
+      *context.GetContext(), {400, 400}, 1);
+  ExperimentalCanvas canvas(context, render_target,
+                            /*requires_readback=*/true);
+  auto inputs = std::make_shared<std::vector<FilterInput::Ref>>();
+  auto filter = std::make_shared<RecordingImageFilter>(inputs);
+
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 400, 400), {.color = Color::Red()});
+  DrawBackdropFilterCard(canvas, Rect::MakeXYWH(0, 0, 100, 100), filter);
+  // Damages the area the next card reads.
+  canvas.DrawRect(Rect::MakeXYWH(220, 20, 20, 20), {.color = Color::Blue()});
+  DrawBackdropFilterCard(canvas, Rect::MakeXYWH(200, 0, 100, 100), filter);
+
+  // The second card first tries the previous backdrop and then reads the
+  // backdrop again.
+  ASSERT_EQ(inputs->size(), 3u);
+  std::shared_ptr<Texture> backdrop = GetInputTexture(inputs->at(0), context);
+  ASSERT_TRUE(backdrop);
+  std::shared_ptr<Texture> new_backdrop =
+      GetInputTexture(inputs->at(2), context);
+  ASSERT_TRUE(new_backdrop);
+  EXPECT_NE(new_backdrop, backdrop);
+
+  canvas.EndReplay();
+}
+
+TEST_P(AiksTest, SiblingSaveLayersOfTheSameSizeKeepTheirContents) {
+  ContentContext context(GetContext(), nullptr);
+  RenderTarget render_target = context.GetRenderTargetCache()->CreateOffscreen(
+      *context.GetContext(), {100, 100}, 1);
+  ExperimentalCanvas canvas(context, render_target,
+                            /*requires_readback=*/false);
+
+  // Both layers need a render target of the same size. The root pass samples
+  // the first layer only after the second layer has been drawn, so the two
+  // layers must not share a texture.
+  canvas.SaveLayer({}, Rect::MakeXYWH(0, 0, 50, 50), nullptr,
+                   ContentBoundsPromise::kContainsContents, Canvas::kMaxDepth,
+                   /*can_distribute_opacity=*/false);
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 50, 50), {.color = Color::Green()});
+  canvas.Restore();
+  canvas.SaveLayer({}, Rect::MakeXYWH(50, 0, 50, 50), nullptr,
+                   ContentBoundsPromise::kContainsContents, Canvas::kMaxDepth,
+                   /*can_distribute_opacity=*/false);
+  canvas.DrawRect(Rect::MakeXYWH(50, 0, 50, 50), {.color = Color::White()});
+  canvas.Restore();
+  canvas.EndReplay();
+
+  // Green and white have the same bytes in RGBA and BGRA formats.
+  std::shared_ptr<Texture> texture = render_target.GetRenderTargetTexture();
+  EXPECT_EQ(ReadPixel(GetContext(), texture, {25, 25}),
+            (std::array<uint8_t, 4>{0, 255, 0, 255}));
+  EXPECT_EQ(ReadPixel(GetContext(), texture, {75, 25}),
+            (std::array<uint8_t, 4>{255, 255, 255, 255}));
+}
+
+TEST_P(AiksTest, BatchesRectsWithSameColorAndTransform) {
+  RecordingCanvasHarness harness(GetContext());
+  ExperimentalCanvas& canvas = harness.canvas();
+  for (int i = 0; i < 3; i++) {
+    canvas.DrawRect(Rect::MakeXYWH(i * 10, 0, 5, 5), {.color = Color::Red()});
+  }
+
+  const std::vector<Command>& commands = harness.EndReplay();
+  ASSERT_EQ(commands.size(), 1u);
+  EXPECT_EQ(GetVertexCount(commands[0]), 18u);
+  EXPECT_EQ(GetFirstVertex(commands[0]), Point(0, 0));
+}
+
+TEST_P(AiksTest, ColorChangeSplitsRectBatch) {
+  RecordingCanvasHarness harness(GetContext());
+  ExperimentalCanvas& canvas = harness.canvas();
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 5, 5), {.color = Color::Red()});
+  canvas.DrawRect(Rect::MakeXYWH(10, 0, 5, 5), {.color = Color::Red()});
+  canvas.DrawRect(Rect::MakeXYWH(20, 0, 5, 5), {.color = Color::Blue()});
+  canvas.DrawRect(Rect::MakeXYWH(30, 0, 5, 5), {.color = Color::Red()});
+
+  const std::vector<Command>& commands = harness.EndReplay();
+  ASSERT_EQ(commands.size(), 3u);
+  EXPECT_EQ(GetVertexCount(commands[0]), 12u);
+  EXPECT_EQ(GetFirstVertex(commands[0]), Point(0, 0));
+  EXPECT_EQ(GetVertexCount(commands[1]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[1]), Point(20, 0));
+  EXPECT_EQ(GetVertexCount(commands[2]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[2]), Point(30, 0));
+}
+
+TEST_P(AiksTest, TransformChangeSplitsRectBatch) {
+  RecordingCanvasHarness harness(GetContext());
+  ExperimentalCanvas& canvas = harness.canvas();
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 5, 5), {.color = Color::Red()});
+  canvas.Translate(Vector3(10, 0));
+  canvas.DrawRect(Rect::MakeXYWH(0, 10, 5, 5), {.color = Color::Red()});
+
+  const std::vector<Command>& commands = harness.EndReplay();
+  ASSERT_EQ(commands.size(), 2u);
+  EXPECT_EQ(GetVertexCount(commands[0]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[0]), Point(0, 0));
+  EXPECT_EQ(GetVertexCount(commands[1]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[1]), Point(0, 10));
+}
+
+TEST_P(AiksTest, ClipSplitsRectBatch) {
+  RecordingCanvasHarness harness(GetContext());
+  ExperimentalCanvas& canvas = harness.canvas();
+  canvas.Save(Canvas::kMaxDepth);
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 5, 5), {.color = Color::Red()});
+  canvas.ClipRect(Rect::MakeXYWH(40, 40, 10, 10),
+                  Entity::ClipOperation::kDifference);
+  canvas.DrawRect(Rect::MakeXYWH(10, 0, 5, 5), {.color = Color::Red()});
+  canvas.Restore();
+
+  // The rect drawn before the clip must not pick up the clip's depth.
+  const std::vector<Command>& commands = harness.EndReplay();
+  ASSERT_GE(commands.size(), 3u);
+  EXPECT_EQ(GetVertexCount(commands.front()), 4u);
+  EXPECT_EQ(GetFirstVertex(commands.front()), Point(0, 0));
+  auto last_rect =
+      std::find_if(commands.begin() + 1, commands.end(), [](const auto& c) {
+        return GetVertexCount(c) == 4u && GetFirstVertex(c) == Point(10, 0);
+      });
+  EXPECT_NE(last_rect, commands.end());
+}
+
+TEST_P(AiksTest, NonRectDrawSplitsRectBatch) {
+  RecordingCanvasHarness harness(GetContext());
+  ExperimentalCanvas& canvas = harness.canvas();
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 5, 5), {.color = Color::Red()});
+  canvas.DrawCircle(Point(50, 50), 5, {.color = Color::Red()});
+  canvas.DrawRect(Rect::MakeXYWH(10, 0, 5, 5), {.color = Color::Red()});
+
+  const std::vector<Command>& commands = harness.EndReplay();
+  ASSERT_EQ(commands.size(), 3u);
+  EXPECT_EQ(GetVertexCount(commands[0]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[0]), Point(0, 0));
+  EXPECT_NE(GetVertexCount(commands[1]), 4u);
+  EXPECT_EQ(GetVertexCount(commands[2]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[2]), Point(10, 0));
+}
+
+TEST_P(AiksTest, SaveLayerSplitsRectBatch) {
+  RecordingCanvasHarness harness(GetContext());
+  ExperimentalCanvas& canvas = harness.canvas();
+  canvas.DrawRect(Rect::MakeXYWH(0, 0, 5, 5), {.color = Color::Red()});
+  canvas.SaveLayer({}, Rect::MakeXYWH(0, 0, 100, 100), nullptr,
+                   ContentBoundsPromise::kContainsContents, Canvas::kMaxDepth,
+                   /*can_distribute_opacity=*/false);
+  canvas.DrawRect(Rect::MakeXYWH(10, 0, 5, 5), {.color = Color::Red()});
+  canvas.Restore();
+  canvas.DrawRect(Rect::MakeXYWH(20, 0, 5, 5), {.color = Color::Red()});
+
+  // The root pass draws the first rect, the layer and the last rect in order.
+  const std::vector<Command>& commands = harness.EndReplay();
+  ASSERT_EQ(commands.size(), 3u);
+  EXPECT_EQ(GetVertexCount(commands[0]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[0]), Point(0, 0));
+  EXPECT_EQ(GetVertexCount(commands[2]), 4u);
+  EXPECT_EQ(GetFirstVertex(commands[2]), Point(20, 0));
+}
+
 }  // namespace testing
 }  // namespace impeller
 
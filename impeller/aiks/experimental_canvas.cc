@@ -17,6 +17,7 @@
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
+#include "impeller/entity/contents/solid_color_contents.h"
 #include "impeller/entity/contents/text_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass_clip_stack.h"
@@ -152,11 +153,30 @@ static std::shared_ptr<Texture> FlipBackdrop(
     }
   }
 
+  render_passes.back().backdrop_texture = input_texture;
+  render_passes.back().backdrop_damage = std::nullopt;
   return input_texture;
 }
 
 }  // namespace
 
+/// Returns the local space rectangle of |entity| if it can be merged with
+/// other solid color rectangles into a single draw.
+///
+/// Only |BlendMode::kSource| is batched since the result of drawing
+/// overlapping rectangles in one draw is then independent of whether they are
+/// drawn separately.
+static std::optional<Rect> GetBatchableRect(const Entity& entity) {
+  if (entity.GetBlendMode() != BlendMode::kSource) {
+    return std::nullopt;
+  }
+  const SolidColorContents* contents = entity.GetContents()->AsSolidColor();
+  if (!contents || !contents->GetGeometry()) {
+    return std::nullopt;
+  }
+  return contents->GetGeometry()->AsFillRect();
+}
+
 static const constexpr RenderTarget::AttachmentConfig kDefaultStencilConfig =
     RenderTarget::AttachmentConfig{
         .storage_mode = StorageMode::kDeviceTransient,
@@ -357,6 +377,7 @@ void ExperimentalCanvas::SaveLayer(
     uint32_t total_content_depth,
     bool can_distribute_opacity) {
   TRACE_EVENT0("flutter", "Canvas::saveLayer");
+  FlushRectBatch();
   if (IsSkipping()) {
     return SkipUntilMatchingRestore(total_content_depth);
   }
@@ -430,24 +451,55 @@ void ExperimentalCanvas::SaveLayer(
           return filter;
         };
 
-    auto input_texture = FlipBackdrop(render_passes_,           //
-                                      GetGlobalPassPosition(),  //
-                                      clip_coverage_stack_,     //
-                                      renderer_                 //
-    );
-    if (!input_texture) {
-      // Validation failures are logged in FlipBackdrop.
-      return;
-    }
-
-    backdrop_filter_contents = backdrop_filter_proc(
-        FilterInput::Make(std::move(input_texture)),
-        transform_stack_.back().transform.Basis(),
-        // When the subpass has a translation that means the math with
-        // the snapshot has to be different.
+    Matrix effect_transform = transform_stack_.back().transform.Basis();
+    // When the subpass has a translation that means the math with the
+    // snapshot has to be different.
+    Entity::RenderingMode rendering_mode =
         transform_stack_.back().transform.HasTranslation()
             ? Entity::RenderingMode::kSubpassPrependSnapshotTransform
-            : Entity::RenderingMode::kSubpassAppendSnapshotTransform);
+            : Entity::RenderingMode::kSubpassAppendSnapshotTransform;
+
+    // Sibling backdrop filters commonly read regions of the pass that nothing
+    // has been rendered to since the previous read back. In that case the
+    // previous backdrop texture is reused instead of ending the pass and
+    // restoring it again. This is only safe when the pass has flipped to a
+    // different texture, as otherwise the backdrop texture is still being
+    // rendered to.
+    const LazyRenderingConfig& current_pass = render_passes_.back();
+    if (current_pass.backdrop_texture &&
+        current_pass.backdrop_texture !=
+            current_pass.inline_pass_context->GetTexture()) {
+      std::shared_ptr<FilterContents> reused_filter_contents =
+          backdrop_filter_proc(
+              FilterInput::Make(current_pass.backdrop_texture),
+              effect_transform, rendering_mode);
+      std::optional<Rect> read_coverage =
+          reused_filter_contents->GetSourceCoverage(
+              effect_transform,
+              subpass_coverage.Shift(-GetGlobalPassPosition()));
+      if (read_coverage.has_value() &&
+          (!current_pass.backdrop_damage.has_value() ||
+           !current_pass.backdrop_damage->IntersectsWithRect(
+               read_coverage.value()))) {
+        backdrop_filter_contents = std::move(reused_filter_contents);
+      }
+    }
+
+    if (!backdrop_filter_contents) {
+      auto input_texture = FlipBackdrop(render_passes_,           //
+                                        GetGlobalPassPosition(),  //
+                                        clip_coverage_stack_,     //
+                                        renderer_                 //
+      );
+      if (!input_texture) {
+        // Validation failures are logged in FlipBackdrop.
+        return;
+      }
+
+      backdrop_filter_contents =
+          backdrop_filter_proc(FilterInput::Make(std::move(input_texture)),
+                               effect_transform, rendering_mode);
+    }
   }
 
   // When applying a save layer, absorb any pending distributed opacity.
@@ -507,6 +559,7 @@ bool ExperimentalCanvas::Restore() {
   if (transform_stack_.size() == 1) {
     return false;
   }
+  FlushRectBatch();
 
   // This check is important to make sure we didn't exceed the depth
   // that the clips were rendered at while rendering any of the
@@ -610,6 +663,7 @@ bool ExperimentalCanvas::Restore() {
       }
     }
 
+    render_passes_.back().AddBackdropDamage(element_entity.GetCoverage());
     element_entity.Render(
         renderer_,                                                         //
         *render_passes_.back().inline_pass_context->GetRenderPass(0).pass  //
@@ -729,10 +783,25 @@ void ExperimentalCanvas::AddRenderEntityToCurrentPass(Entity entity,
     entity.SetBlendMode(BlendMode::kSource);
   }
 
+  // Solid color rectangles that match the color and transform of the pending
+  // batch are appended to it. Anything else must render after the batch.
+  std::optional<Rect> batch_rect = GetBatchableRect(entity);
+  Color batch_color;
+  if (batch_rect.has_value()) {
+    batch_color = entity.GetContents()->AsSolidColor()->GetColor();
+  }
+  bool joins_batch = batch_rect.has_value() &&
+                     !pending_rect_batch_.rects.empty() &&
+                     pending_rect_batch_.transform == entity.GetTransform() &&
+                     pending_rect_batch_.color == batch_color;
+  if (!joins_batch) {
+    FlushRectBatch();
+  }
+
   // If the entity covers the current render target and is a solid color, then
   // conditionally update the backdrop color to its solid color value blended
   // with the current backdrop.
-  if (render_passes_.back().IsApplyingClearColor()) {
+  if (!joins_batch && render_passes_.back().IsApplyingClearColor()) {
     std::optional<Color> maybe_color = entity.AsBackgroundColor(
         render_passes_.back().inline_pass_context->GetTexture()->GetSize());
     if (maybe_color.has_value()) {
@@ -762,6 +831,18 @@ void ExperimentalCanvas::AddRenderEntityToCurrentPass(Entity entity,
       << current_depth_ << " <=? " << transform_stack_.back().clip_depth;
   entity.SetClipDepth(current_depth_);
 
+  if (batch_rect.has_value()) {
+    if (!joins_batch) {
+      pending_rect_batch_.transform = entity.GetTransform();
+      pending_rect_batch_.color = batch_color;
+    }
+    // Every rectangle in the batch is under the same clip state, so drawing
+    // all of them at the depth of the last one is equivalent.
+    pending_rect_batch_.clip_depth = current_depth_;
+    pending_rect_batch_.rects.push_back(batch_rect.value());
+    return;
+  }
+
   if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
     if (renderer_.GetDeviceCapabilities().SupportsFramebufferFetch()) {
       ApplyFramebufferBlend(entity);
@@ -808,6 +889,36 @@ void ExperimentalCanvas::AddRenderEntityToCurrentPass(Entity entity,
     return;
   }
 
+  render_passes_.back().AddBackdropDamage(entity.GetCoverage());
+  entity.Render(renderer_, *result.pass);
+}
+
+void ExperimentalCanvas::FlushRectBatch() {
+  if (pending_rect_batch_.rects.empty()) {
+    return;
+  }
+
+  auto contents = std::make_shared<SolidColorContents>();
+  contents->SetColor(pending_rect_batch_.color);
+  if (pending_rect_batch_.rects.size() == 1u) {
+    contents->SetGeometry(Geometry::MakeRect(pending_rect_batch_.rects[0]));
+  } else {
+    contents->SetGeometry(Geometry::MakeFillRects(pending_rect_batch_.rects));
+  }
+  pending_rect_batch_.rects.clear();
+
+  Entity entity;
+  entity.SetTransform(pending_rect_batch_.transform);
+  entity.SetBlendMode(BlendMode::kSource);
+  entity.SetClipDepth(pending_rect_batch_.clip_depth);
+  entity.SetContents(std::move(contents));
+
+  InlinePassContext::RenderPassResult result =
+      render_passes_.back().inline_pass_context->GetRenderPass(0);
+  if (!result.pass) {
+    return;
+  }
+  render_passes_.back().AddBackdropDamage(entity.GetCoverage());
   entity.Render(renderer_, *result.pass);
 }
 
@@ -815,6 +926,7 @@ void ExperimentalCanvas::AddClipEntityToCurrentPass(Entity entity) {
   if (IsSkipping()) {
     return;
   }
+  FlushRectBatch();
 
   auto transform = entity.GetTransform();
   entity.SetTransform(
@@ -930,6 +1042,7 @@ bool ExperimentalCanvas::BlitToOnscreen() {
 
 void ExperimentalCanvas::EndReplay() {
   FML_DCHECK(render_passes_.size() == 1u);
+  FlushRectBatch();
   render_passes_.back().inline_pass_context->GetRenderPass(0);
   render_passes_.back().inline_pass_context->EndPass();
 
@@ -939,6 +1052,9 @@ void ExperimentalCanvas::EndReplay() {
   if (requires_readback_) {
     BlitToOnscreen();
   }
+  if (!renderer_.GetContext()->GetCommandQueue()->Flush().ok()) {
+    VALIDATION_LOG << "Failed to submit pending command buffers.";
+  }
 
   render_passes_.clear();
   renderer_.GetRenderTargetCache()->End();
@@ -22,9 +22,27 @@ struct LazyRenderingConfig {
   std::unique_ptr<EntityPassTarget> entity_pass_target;
   std::unique_ptr<InlinePassContext> inline_pass_context;
 
+  /// The texture most recently read back from this pass for an advanced
+  /// blend or backdrop filter, if any.
+  std::shared_ptr<Texture> backdrop_texture;
+
+  /// The pass local area rendered to since `backdrop_texture` was read back.
+  /// Outside of this area, `backdrop_texture` still matches the pass contents.
+  std::optional<Rect> backdrop_damage;
+
   /// Whether or not the clear color texture can still be updated.
   bool IsApplyingClearColor() const { return !inline_pass_context->IsActive(); }
 
+  /// Record that |coverage| of this pass was rendered to.
+  void AddBackdropDamage(std::optional<Rect> coverage) {
+    if (backdrop_texture && coverage.has_value()) {
+      // Expand by a pixel to account for filtering when the backdrop texture
+      // is sampled right next to the damaged area.
+      backdrop_damage = Rect::Union(
+          backdrop_damage, Rect::RoundOut(coverage.value()).Expand(1));
+    }
+  }
+
   LazyRenderingConfig(ContentContext& renderer,
                       std::unique_ptr<EntityPassTarget> p_entity_pass_target)
       : entity_pass_target(std::move(p_entity_pass_target)) {
@@ -113,8 +131,22 @@ class ExperimentalCanvas : public Canvas {
   std::vector<LazyRenderingConfig> render_passes_;
   std::vector<SaveLayerState> save_layer_state_;
 
+  /// Consecutive solid color rectangles drawn with the same color and
+  /// transform are collected here and rendered with a single draw.
+  struct PendingRectBatch {
+    Matrix transform;
+    Color color;
+    uint32_t clip_depth = 0u;
+    std::vector<Rect> rects;
+  };
+  PendingRectBatch pending_rect_batch_;
+
   void SetupRenderPass();
 
+  /// @brief Render any rectangles collected in the pending rect batch to the
+  ///        current pass.
+  void FlushRectBatch();
+
   void AddRenderEntityToCurrentPass(Entity entity, bool reuse_depth) override;
   void AddClipEntityToCurrentPass(Entity entity) override;
   bool BlitToOnscreen();
@@ -170,6 +170,27 @@ TEST_P(AiksTest, CanRenderBackdropBlurHugeSigma) {
   ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
 }
 
+// Sigmas that downsample the input to 1/8 and 1/16 of its size.
+TEST_P(AiksTest, CanRenderLargeSigmaBlurs) {
+  DisplayListBuilder builder;
+  builder.Scale(GetContentScale().x, GetContentScale().y);
+
+  DlPaint paint;
+  paint.setColor(DlColor::kGreen());
+  paint.setImageFilter(DlBlurImageFilter::Make(40, 40, DlTileMode::kDecal));
+  builder.DrawRect(SkRect::MakeXYWH(100, 100, 200, 200), paint);
+
+  builder.Save();
+  builder.Translate(450, 100);
+  builder.Scale(2, 2);
+  paint.setColor(DlColor::kBlue());
+  paint.setImageFilter(DlBlurImageFilter::Make(200, 200, DlTileMode::kDecal));
+  builder.DrawRect(SkRect::MakeXYWH(0, 0, 100, 100), paint);
+  builder.Restore();
+
+  ASSERT_TRUE(OpenPlaygroundHere(builder.Build()));
+}
+
 TEST_P(AiksTest, CanRenderClippedBlur) {
   DisplayListBuilder builder;
   builder.ClipRect(SkRect::MakeXYWH(100, 150, 400, 400));
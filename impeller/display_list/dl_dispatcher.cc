@@ -874,7 +874,10 @@ void DlDispatcherBase::clipPath(const DlPath& path, ClipOp sk_op, bool is_aa) {
                             skia_conversions::ToSize(rrect.getSimpleRadii()),
                             clip_op);
     } else {
-      GetCanvas().ClipPath(path.GetPath(), clip_op);
+      // Display list paths are typically pushed again with the same path data
+      // every frame, unlike the paths built for complex rrects in |clipRRect|.
+      GetCanvas().ClipPath(path.GetPath(), clip_op,
+                           /*retain_tessellation=*/true);
     }
   }
 }
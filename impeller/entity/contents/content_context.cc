@@ -5,8 +5,12 @@
 #include "impeller/entity/contents/content_context.h"
 
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
 #include <utility>
 
+#include "flutter/fml/mapping.h"
 #include "fml/trace_event.h"
 #include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
@@ -14,6 +18,7 @@
 #include "impeller/core/texture_descriptor.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_descriptor.h"
@@ -25,6 +30,49 @@
 
 namespace impeller {
 
+/// The first line of a serialized pipeline usage profile. Each following line
+/// names a variant container and the packed |ContentContextOptions::Hash| of
+/// a variant that was created from it.
+static constexpr std::string_view kPipelineUsageProfileHeader =
+    "impeller-pipeline-usage-v1";
+
+std::optional<ContentContextOptions> ContentContextOptions::FromKey(
+    uint64_t key) {
+  auto field = [key](int shift) -> uint64_t { return (key >> shift) & 0xff; };
+  const uint64_t sample_count = field(48);
+  if (sample_count != static_cast<uint64_t>(SampleCount::kCount1) &&
+      sample_count != static_cast<uint64_t>(SampleCount::kCount4)) {
+    return std::nullopt;
+  }
+  if (field(40) > static_cast<uint64_t>(BlendMode::kLast) ||
+      field(32) > static_cast<uint64_t>(CompareFunction::kGreaterEqual) ||
+      field(24) > static_cast<uint64_t>(
+                      ContentContextOptions::StencilMode::
+                          kOverdrawPreventionRestore) ||
+      field(16) > static_cast<uint64_t>(PrimitiveType::kPoint) ||
+      field(8) > static_cast<uint64_t>(PixelFormat::kD32FloatS8UInt)) {
+    return std::nullopt;
+  }
+  ContentContextOptions options{
+      .sample_count = static_cast<SampleCount>(sample_count),
+      .blend_mode = static_cast<BlendMode>(field(40)),
+      .depth_compare = static_cast<CompareFunction>(field(32)),
+      .stencil_mode =
+          static_cast<ContentContextOptions::StencilMode>(field(24)),
+      .primitive_type = static_cast<PrimitiveType>(field(16)),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(field(8)),
+      .has_depth_stencil_attachments = ((key >> 2) & 1u) != 0u,
+      .depth_write_enabled = ((key >> 3) & 1u) != 0u,
+      .wireframe = ((key >> 1) & 1u) != 0u,
+      .is_for_rrect_blur_clear = (key & 1u) != 0u,
+  };
+  // Reject any stray bits the packing doesn't know about.
+  if (ContentContextOptions::Hash{}(options) != key) {
+    return std::nullopt;
+  }
+  return options;
+}
+
 void ContentContextOptions::ApplyToPipelineDescriptor(
     PipelineDescriptor& desc) const {
   auto pipeline_blend = blend_mode;
@@ -246,6 +294,8 @@ ContentContext::ContentContext(
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_cache_(std::make_unique<TessellationCache>(
+          context_->GetResourceAllocator())),
       render_target_cache_(render_target_allocator == nullptr
                                ? std::make_shared<RenderTargetCache>(
                                      context_->GetResourceAllocator())
@@ -462,6 +512,8 @@ ContentContext::ContentContext(
 #endif  // IMPELLER_ENABLE_OPENGLES
 
   is_valid_ = true;
+  RegisterPipelineVariants();
+  PrewarmPipelineVariants();
   InitializeCommonlyUsedShadersIfNeeded();
 }
 
@@ -547,6 +599,10 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+TessellationCache& ContentContext::GetTessellationCache() const {
+  return *tessellation_cache_;
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
@@ -585,6 +641,162 @@ void ContentContext::ClearCachedRuntimeEffectPipeline(
   }
 }
 
+void ContentContext::RegisterPipelineVariants() {
+  // The names are persisted in the usage profile. Don't rename them without
+  // also bumping kPipelineUsageProfileHeader.
+  auto register_variants = [this](std::string_view name,
+                                  VariantsBase& variants) {
+    variants.SetProfileName(name);
+    variants_by_name_[name] = &variants;
+  };
+  register_variants("solid_fill_pipelines", solid_fill_pipelines_);
+  register_variants("fast_gradient_pipelines", fast_gradient_pipelines_);
+  register_variants("linear_gradient_fill_pipelines",
+                    linear_gradient_fill_pipelines_);
+  register_variants("radial_gradient_fill_pipelines",
+                    radial_gradient_fill_pipelines_);
+  register_variants("conical_gradient_fill_pipelines",
+                    conical_gradient_fill_pipelines_);
+  register_variants("sweep_gradient_fill_pipelines",
+                    sweep_gradient_fill_pipelines_);
+  register_variants("linear_gradient_ssbo_fill_pipelines",
+                    linear_gradient_ssbo_fill_pipelines_);
+  register_variants("radial_gradient_ssbo_fill_pipelines",
+                    radial_gradient_ssbo_fill_pipelines_);
+  register_variants("conical_gradient_ssbo_fill_pipelines",
+                    conical_gradient_ssbo_fill_pipelines_);
+  register_variants("sweep_gradient_ssbo_fill_pipelines",
+                    sweep_gradient_ssbo_fill_pipelines_);
+  register_variants("rrect_blur_pipelines", rrect_blur_pipelines_);
+  register_variants("texture_pipelines", texture_pipelines_);
+  register_variants("texture_downsample_pipelines",
+                    texture_downsample_pipelines_);
+  register_variants("texture_strict_src_pipelines",
+                    texture_strict_src_pipelines_);
+#ifdef IMPELLER_ENABLE_OPENGLES
+  register_variants("tiled_texture_external_pipelines",
+                    tiled_texture_external_pipelines_);
+#endif  // IMPELLER_ENABLE_OPENGLES
+  register_variants("tiled_texture_pipelines", tiled_texture_pipelines_);
+  register_variants("gaussian_blur_pipelines", gaussian_blur_pipelines_);
+  register_variants("border_mask_blur_pipelines", border_mask_blur_pipelines_);
+  register_variants("morphology_filter_pipelines",
+                    morphology_filter_pipelines_);
+  register_variants("color_matrix_color_filter_pipelines",
+                    color_matrix_color_filter_pipelines_);
+  register_variants("linear_to_srgb_filter_pipelines",
+                    linear_to_srgb_filter_pipelines_);
+  register_variants("srgb_to_linear_filter_pipelines",
+                    srgb_to_linear_filter_pipelines_);
+  register_variants("clip_pipelines", clip_pipelines_);
+  register_variants("glyph_atlas_pipelines", glyph_atlas_pipelines_);
+  register_variants("yuv_to_rgb_filter_pipelines",
+                    yuv_to_rgb_filter_pipelines_);
+  register_variants("porter_duff_blend_pipelines",
+                    porter_duff_blend_pipelines_);
+  register_variants("blend_color_pipelines", blend_color_pipelines_);
+  register_variants("blend_colorburn_pipelines", blend_colorburn_pipelines_);
+  register_variants("blend_colordodge_pipelines", blend_colordodge_pipelines_);
+  register_variants("blend_darken_pipelines", blend_darken_pipelines_);
+  register_variants("blend_difference_pipelines", blend_difference_pipelines_);
+  register_variants("blend_exclusion_pipelines", blend_exclusion_pipelines_);
+  register_variants("blend_hardlight_pipelines", blend_hardlight_pipelines_);
+  register_variants("blend_hue_pipelines", blend_hue_pipelines_);
+  register_variants("blend_lighten_pipelines", blend_lighten_pipelines_);
+  register_variants("blend_luminosity_pipelines", blend_luminosity_pipelines_);
+  register_variants("blend_multiply_pipelines", blend_multiply_pipelines_);
+  register_variants("blend_overlay_pipelines", blend_overlay_pipelines_);
+  register_variants("blend_saturation_pipelines", blend_saturation_pipelines_);
+  register_variants("blend_screen_pipelines", blend_screen_pipelines_);
+  register_variants("blend_softlight_pipelines", blend_softlight_pipelines_);
+  register_variants("framebuffer_blend_color_pipelines",
+                    framebuffer_blend_color_pipelines_);
+  register_variants("framebuffer_blend_colorburn_pipelines",
+                    framebuffer_blend_colorburn_pipelines_);
+  register_variants("framebuffer_blend_colordodge_pipelines",
+                    framebuffer_blend_colordodge_pipelines_);
+  register_variants("framebuffer_blend_darken_pipelines",
+                    framebuffer_blend_darken_pipelines_);
+  register_variants("framebuffer_blend_difference_pipelines",
+                    framebuffer_blend_difference_pipelines_);
+  register_variants("framebuffer_blend_exclusion_pipelines",
+                    framebuffer_blend_exclusion_pipelines_);
+  register_variants("framebuffer_blend_hardlight_pipelines",
+                    framebuffer_blend_hardlight_pipelines_);
+  register_variants("framebuffer_blend_hue_pipelines",
+                    framebuffer_blend_hue_pipelines_);
+  register_variants("framebuffer_blend_lighten_pipelines",
+                    framebuffer_blend_lighten_pipelines_);
+  register_variants("framebuffer_blend_luminosity_pipelines",
+                    framebuffer_blend_luminosity_pipelines_);
+  register_variants("framebuffer_blend_multiply_pipelines",
+                    framebuffer_blend_multiply_pipelines_);
+  register_variants("framebuffer_blend_overlay_pipelines",
+                    framebuffer_blend_overlay_pipelines_);
+  register_variants("framebuffer_blend_saturation_pipelines",
+                    framebuffer_blend_saturation_pipelines_);
+  register_variants("framebuffer_blend_screen_pipelines",
+                    framebuffer_blend_screen_pipelines_);
+  register_variants("framebuffer_blend_softlight_pipelines",
+                    framebuffer_blend_softlight_pipelines_);
+  register_variants("vertices_uber_shader", vertices_uber_shader_);
+}
+
+void ContentContext::PrewarmPipelineVariants() {
+  std::shared_ptr<const fml::Mapping> profile =
+      context_->GetPipelineLibrary()->GetUsageProfile();
+  if (!profile || profile->GetMapping() == nullptr) {
+    return;
+  }
+  TRACE_EVENT0("flutter", "PrewarmPipelineVariants");
+
+  std::istringstream stream(
+      std::string(reinterpret_cast<const char*>(profile->GetMapping()),
+                  profile->GetSize()));
+  std::string line;
+  if (!std::getline(stream, line) || line != kPipelineUsageProfileHeader) {
+    return;
+  }
+  pipeline_usage_profile_ = line + "\n";
+  while (std::getline(stream, line)) {
+    std::istringstream entry(line);
+    std::string name;
+    uint64_t key = 0u;
+    if (!(entry >> name >> std::hex >> key)) {
+      continue;
+    }
+    auto found = variants_by_name_.find(name);
+    if (found == variants_by_name_.end()) {
+      continue;
+    }
+    std::optional<ContentContextOptions> options =
+        ContentContextOptions::FromKey(key);
+    if (!options.has_value()) {
+      continue;
+    }
+    if (found->second->Prewarm(*context_, options.value())) {
+      pipeline_usage_profile_ += line + "\n";
+    }
+  }
+}
+
+void ContentContext::RecordPipelineVariant(
+    const VariantsBase& container,
+    const ContentContextOptions& options) const {
+  if (container.GetProfileName().empty()) {
+    return;
+  }
+  if (pipeline_usage_profile_.empty()) {
+    pipeline_usage_profile_ = std::string(kPipelineUsageProfileHeader) + "\n";
+  }
+  pipeline_usage_profile_ +=
+      SPrintF("%s %llx\n", std::string(container.GetProfileName()).c_str(),
+              static_cast<unsigned long long>(
+                  ContentContextOptions::Hash{}(options)));
+  context_->GetPipelineLibrary()->SetUsageProfile(
+      std::make_shared<fml::DataMapping>(pipeline_usage_profile_));
+}
+
 void ContentContext::InitializeCommonlyUsedShadersIfNeeded() const {
   TRACE_EVENT0("flutter", "InitializeCommonlyUsedShadersIfNeeded");
   GetContext()->InitializeCommonlyUsedShadersIfNeeded();
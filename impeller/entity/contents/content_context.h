@@ -8,10 +8,13 @@
 #include <initializer_list>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "flutter/fml/logging.h"
 #include "flutter/fml/status_or.h"
+#include "impeller/base/strings.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
 #include "impeller/core/host_buffer.h"
@@ -19,6 +22,7 @@
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
+#include "impeller/renderer/pipeline_library.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/typographer_context.h"
@@ -357,10 +361,16 @@ struct ContentContextOptions {
     }
   };
 
+  /// Unpacks a key produced by |Hash|. Returns std::nullopt for keys that no
+  /// set of options packs to, such as keys from a stale or corrupt pipeline
+  /// usage profile.
+  static std::optional<ContentContextOptions> FromKey(uint64_t key);
+
   void ApplyToPipelineDescriptor(PipelineDescriptor& desc) const;
 };
 
 class Tessellator;
+class TessellationCache;
 class RenderTargetCache;
 
 class ContentContext {
@@ -376,6 +386,10 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  /// @brief Tessellations of paths that are drawn again every frame, such as
+  ///        clip paths, that are retained across frames.
+  TessellationCache& GetTessellationCache() const;
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetFastGradientPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(fast_gradient_pipelines_, opts);
@@ -790,6 +804,29 @@ class ContentContext {
                              RuntimeEffectPipelineKey::Equal>
       runtime_effect_pipelines_;
 
+  /// The type erased interface of |Variants| used to prewarm pipeline
+  /// variants recorded in the usage profile of a previous run.
+  class VariantsBase {
+   public:
+    virtual ~VariantsBase() = default;
+
+    /// Start creating the variant for the given options on the worker pool
+    /// if it doesn't already exist.
+    ///
+    /// Returns whether a new variant was created.
+    virtual bool Prewarm(const Context& context,
+                         const ContentContextOptions& options) = 0;
+
+    /// The stable name under which variants are recorded in the usage
+    /// profile.
+    std::string_view GetProfileName() const { return profile_name_; }
+
+    void SetProfileName(std::string_view name) { profile_name_ = name; }
+
+   private:
+    std::string_view profile_name_;
+  };
+
   /// Holds multiple Pipelines associated with the same PipelineHandle types.
   ///
   /// For example, it may have multiple
@@ -804,7 +841,7 @@ class ContentContext {
   ///  - impeller::RenderPipelineHandle<> - The type of objects this typically
   ///    contains.
   template <class PipelineHandleT>
-  class Variants {
+  class Variants : public VariantsBase {
    public:
     Variants() = default;
 
@@ -848,6 +885,30 @@ class ContentContext {
 
     size_t GetPipelineCount() const { return pipelines_.size(); }
 
+    // |VariantsBase|
+    bool Prewarm(const Context& context,
+                 const ContentContextOptions& options) override {
+      if (Get(options)) {
+        return false;
+      }
+      PipelineHandleT* default_handle = GetDefault();
+      if (!default_handle) {
+        return false;
+      }
+      // The descriptor is known without waiting for the default pipeline.
+      std::optional<PipelineDescriptor> desc = default_handle->GetDescriptor();
+      if (!desc.has_value()) {
+        return false;
+      }
+      options.ApplyToPipelineDescriptor(*desc);
+      desc->SetLabel(
+          SPrintF("%s V#%zu", desc->GetLabel().c_str(), GetPipelineCount()));
+      Set(options, std::make_unique<PipelineHandleT>(
+                       context.GetPipelineLibrary()->GetPipeline(
+                           std::move(desc), /*async=*/true)));
+      return true;
+    }
+
    private:
     std::optional<ContentContextOptions> default_options_;
     std::unordered_map<ContentContextOptions,
@@ -997,11 +1058,30 @@ class ContentContext {
     std::unique_ptr<RenderPipelineHandleT> variant =
         std::make_unique<RenderPipelineHandleT>(std::move(variant_future));
     container.Set(opts, std::move(variant));
+    RecordPipelineVariant(container, opts);
     return container.Get(opts);
   }
 
+  /// Maps the names used in the pipeline usage profile to the variant
+  /// containers above.
+  std::unordered_map<std::string_view, VariantsBase*> variants_by_name_;
+  /// The serialized usage profile of this and earlier runs. See
+  /// |PipelineLibrary::GetUsageProfile|.
+  mutable std::string pipeline_usage_profile_;
+
+  void RegisterPipelineVariants();
+
+  /// Create all variants recorded in the usage profile of a previous run on
+  /// the concurrent worker pool so they don't have to be created
+  /// synchronously on first use.
+  void PrewarmPipelineVariants();
+
+  void RecordPipelineVariant(const VariantsBase& container,
+                             const ContentContextOptions& options) const;
+
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::unique_ptr<TessellationCache> tessellation_cache_;
   std::shared_ptr<RenderTargetAllocator> render_target_cache_;
   std::shared_ptr<HostBuffer> host_buffer_;
   std::shared_ptr<Texture> empty_texture_;
@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <optional>
+
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+#include "impeller/entity/contents/content_context.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(ContentContextOptionsTest, KeyRoundTrips) {
+  const ContentContextOptions options[] = {
+      {},
+      {
+          .sample_count = SampleCount::kCount4,
+          .blend_mode = BlendMode::kLast,
+          .depth_compare = CompareFunction::kGreaterEqual,
+          .stencil_mode =
+              ContentContextOptions::StencilMode::kOverdrawPreventionRestore,
+          .primitive_type = PrimitiveType::kPoint,
+          .color_attachment_pixel_format = PixelFormat::kD32FloatS8UInt,
+          .has_depth_stencil_attachments = false,
+          .depth_write_enabled = true,
+          .wireframe = true,
+          .is_for_rrect_blur_clear = true,
+      },
+      {
+          .blend_mode = BlendMode::kSource,
+          .stencil_mode = ContentContextOptions::StencilMode::kCoverCompare,
+          .primitive_type = PrimitiveType::kTriangleStrip,
+          .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+      },
+  };
+  for (const ContentContextOptions& original : options) {
+    const uint64_t key = ContentContextOptions::Hash{}(original);
+    std::optional<ContentContextOptions> unpacked =
+        ContentContextOptions::FromKey(key);
+    ASSERT_TRUE(unpacked.has_value());
+    EXPECT_TRUE(ContentContextOptions::Equal{}(original, unpacked.value()));
+    EXPECT_EQ(ContentContextOptions::Hash{}(unpacked.value()), key);
+  }
+}
+
+TEST(ContentContextOptionsTest, RejectsInvalidKeys) {
+  const uint64_t key = ContentContextOptions::Hash{}({});
+  ASSERT_TRUE(ContentContextOptions::FromKey(key).has_value());
+
+  // Bits 4 to 7 are unused.
+  EXPECT_FALSE(ContentContextOptions::FromKey(key | 1u << 4).has_value());
+  // Two samples aren't supported.
+  EXPECT_FALSE(
+      ContentContextOptions::FromKey((key & ~(0xffllu << 48)) | 2llu << 48)
+          .has_value());
+  // Out of range blend mode.
+  EXPECT_FALSE(
+      ContentContextOptions::FromKey(
+          (key & ~(0xffllu << 40)) |
+          (static_cast<uint64_t>(BlendMode::kLast) + 1) << 40)
+          .has_value());
+  // Bits beyond the sample count.
+  EXPECT_FALSE(ContentContextOptions::FromKey(key | 1llu << 56).has_value());
+}
+
+}  // namespace testing
+}  // namespace impeller
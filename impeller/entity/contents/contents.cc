@@ -146,6 +146,10 @@ const FilterContents* Contents::AsFilter() const {
   return nullptr;
 }
 
+const SolidColorContents* Contents::AsSolidColor() const {
+  return nullptr;
+}
+
 bool Contents::ApplyColorFilter(
     const Contents::ColorFilterProc& color_filter_proc) {
   return false;
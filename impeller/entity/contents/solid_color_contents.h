@@ -44,6 +44,9 @@ class SolidColorContents final : public ColorSourceContents {
   std::optional<Color> AsBackgroundColor(const Entity& entity,
                                          ISize target_size) const override;
 
+  // |Contents|
+  const SolidColorContents* AsSolidColor() const override;
+
   // |Contents|
   [[nodiscard]] bool ApplyColorFilter(
       const ColorFilterProc& color_filter_proc) override;
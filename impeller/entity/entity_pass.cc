@@ -233,6 +233,11 @@ bool EntityPass::Render(ContentContext& renderer,
                         const RenderTarget& render_target) const {
   renderer.GetRenderTargetCache()->Start();
   fml::ScopedCleanupClosure reset_state([&renderer]() {
+    // Offscreen passes are enqueued rather than submitted individually. Make
+    // sure all of them reach the GPU by the end of the frame.
+    if (!renderer.GetContext()->GetCommandQueue()->Flush().ok()) {
+      VALIDATION_LOG << "Failed to submit pending command buffers.";
+    }
     renderer.GetLazyGlyphAtlas()->ResetTextFrames();
     renderer.GetRenderTargetCache()->End();
   });
@@ -40,6 +40,7 @@
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
 #include "impeller/entity/geometry/superellipse_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
@@ -2332,6 +2333,22 @@ TEST_P(EntityTest, TextContentsCeilsGlyphScaleToDecimal) {
   ASSERT_EQ(TextFrame::RoundScaledFontSize(100000000.0f, 12), 48.0f);
 }
 
+TEST_P(EntityTest, TextContentsQuantizesLargeGlyphScales) {
+  // Small glyphs keep the fine grained rounding.
+  ASSERT_NE(TextFrame::RoundScaledFontSize(1.0f, 12),
+            TextFrame::RoundScaledFontSize(1.01f, 12));
+
+  // Large glyphs share a rasterized size across nearby scales.
+  ASSERT_EQ(TextFrame::RoundScaledFontSize(4.0f, 50),
+            TextFrame::RoundScaledFontSize(4.01f, 50));
+
+  // But never deviate from the requested size by more than a step.
+  for (Scalar scale = 1.0f; scale < 20.0f; scale += 0.37f) {
+    Scalar rounded = TextFrame::RoundScaledFontSize(scale, 24);
+    ASSERT_NEAR(rounded / scale, 1.0f, 0.01f);
+  }
+}
+
 TEST_P(EntityTest, AdvancedBlendCoverageHintIsNotResetByEntityPass) {
   if (GetContext()->GetCapabilities()->SupportsFramebufferFetch()) {
     GTEST_SKIP() << "Backends that support framebuffer fetch dont use coverage "
@@ -2497,6 +2514,33 @@ TEST_P(EntityTest, FillPathGeometryGetPositionBufferReturnsExpectedMode) {
   }
 }
 
+TEST_P(EntityTest, FillPathGeometryOnlyCachesRetainedTessellations) {
+  RenderTarget target;
+  testing::MockRenderPass mock_pass(GetContext(), target);
+  std::shared_ptr<ContentContext> content_context = GetContentContext();
+  const TessellationCache& cache = content_context->GetTessellationCache();
+  Path path = PathBuilder{}
+                  .AddRoundedRect(Rect::MakeLTRB(0, 0, 100, 100), 10)
+                  .TakePath();
+
+  auto non_retained = Geometry::MakeFillPath(path);
+  for (auto i = 0; i < 2; i++) {
+    GeometryResult result =
+        non_retained->GetPositionBuffer(*content_context, {}, mock_pass);
+    EXPECT_GT(result.vertex_buffer.vertex_count, 0u);
+  }
+  EXPECT_EQ(cache.GetEntryCountForTesting(), 0u);
+
+  auto retained = Geometry::MakeFillPath(path, /*inner_rect=*/std::nullopt,
+                                         /*retain_tessellation=*/true);
+  for (auto i = 0; i < 2; i++) {
+    GeometryResult result =
+        retained->GetPositionBuffer(*content_context, {}, mock_pass);
+    EXPECT_GT(result.vertex_buffer.vertex_count, 0u);
+  }
+  EXPECT_EQ(cache.GetEntryCountForTesting(), 1u);
+}
+
 TEST_P(EntityTest, FailOnValidationError) {
   if (GetParam() != PlaygroundBackend::kVulkan) {
     GTEST_SKIP() << "Validation is only fatal on Vulkan backend.";
@@ -9,12 +9,16 @@
 #include "impeller/core/vertex_buffer.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 
 namespace impeller {
 
 FillPathGeometry::FillPathGeometry(const Path& path,
-                                   std::optional<Rect> inner_rect)
-    : path_(path), inner_rect_(inner_rect) {}
+                                   std::optional<Rect> inner_rect,
+                                   bool retain_tessellation)
+    : path_(path),
+      inner_rect_(inner_rect),
+      retain_tessellation_(retain_tessellation) {}
 
 GeometryResult FillPathGeometry::GetPositionBuffer(
     const ContentContext& renderer,
@@ -36,8 +40,16 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     };
   }
 
-  VertexBuffer vertex_buffer = renderer.GetTessellator()->TessellateConvex(
-      path_, host_buffer, entity.GetTransform().GetMaxBasisLength());
+  Scalar scale = entity.GetTransform().GetMaxBasisLength();
+  VertexBuffer vertex_buffer;
+  if (retain_tessellation_) {
+    vertex_buffer =
+        renderer.GetTessellationCache().TessellateConvex(path_, scale);
+  }
+  if (!vertex_buffer) {
+    vertex_buffer = renderer.GetTessellator()->TessellateConvex(
+        path_, host_buffer, scale);
+  }
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
@@ -15,8 +15,12 @@ namespace impeller {
 /// @brief A geometry that is created from a filled path object.
 class FillPathGeometry final : public Geometry {
  public:
+  /// If |retain_tessellation| is true, the tessellation is looked up in and
+  /// stored to the |TessellationCache| of the content context instead of being
+  /// recomputed into the per-frame host buffer.
   explicit FillPathGeometry(const Path& path,
-                            std::optional<Rect> inner_rect = std::nullopt);
+                            std::optional<Rect> inner_rect = std::nullopt,
+                            bool retain_tessellation = false);
 
   ~FillPathGeometry() = default;
 
@@ -37,6 +41,7 @@ class FillPathGeometry final : public Geometry {
 
   Path path_;
   std::optional<Rect> inner_rect_;
+  bool retain_tessellation_ = false;
 
   FillPathGeometry(const FillPathGeometry&) = delete;
 
@@ -0,0 +1,62 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/fill_rects_geometry.h"
+
+namespace impeller {
+
+FillRectsGeometry::FillRectsGeometry(std::vector<Rect> rects)
+    : rects_(std::move(rects)) {}
+
+GeometryResult FillRectsGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  if (rects_.empty()) {
+    return kEmptyResult;
+  }
+
+  // Each rectangle is emitted as two triangles so that the whole list can be
+  // drawn with a single non-indexed draw.
+  size_t vertex_count = rects_.size() * 6;
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  BufferView buffer_view = host_buffer.Emplace(
+      vertex_count * sizeof(Point), alignof(Point), [&](uint8_t* data) {
+        Point* vertices = reinterpret_cast<Point*>(data);
+        for (const Rect& rect : rects_) {
+          std::array<Point, 4> points = rect.GetPoints();
+          *vertices++ = points[0];
+          *vertices++ = points[1];
+          *vertices++ = points[2];
+          *vertices++ = points[1];
+          *vertices++ = points[2];
+          *vertices++ = points[3];
+        }
+      });
+
+  return GeometryResult{
+      .type = PrimitiveType::kTriangle,
+      .vertex_buffer =
+          {
+              .vertex_buffer = std::move(buffer_view),
+              .vertex_count = vertex_count,
+              .index_type = IndexType::kNone,
+          },
+      .transform = entity.GetShaderTransform(pass),
+  };
+}
+
+std::optional<Rect> FillRectsGeometry::GetCoverage(
+    const Matrix& transform) const {
+  if (rects_.empty()) {
+    return std::nullopt;
+  }
+  Rect coverage = rects_.front();
+  for (const Rect& rect : rects_) {
+    coverage = coverage.Union(rect);
+  }
+  return coverage.TransformBounds(transform);
+}
+
+}  // namespace impeller
@@ -0,0 +1,43 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_FILL_RECTS_GEOMETRY_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_FILL_RECTS_GEOMETRY_H_
+
+#include <vector>
+
+#include "impeller/entity/geometry/geometry.h"
+
+namespace impeller {
+
+/// @brief A geometry that fills a list of rectangles with a single draw.
+///
+///        Overlapping rectangles are drawn once per rectangle, so this is only
+///        equivalent to drawing the rectangles individually when the blend
+///        mode does not depend on the destination (e.g. |BlendMode::kSource|).
+class FillRectsGeometry final : public Geometry {
+ public:
+  explicit FillRectsGeometry(std::vector<Rect> rects);
+
+  ~FillRectsGeometry() = default;
+
+  // |Geometry|
+  GeometryResult GetPositionBuffer(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const override;
+
+  // |Geometry|
+  std::optional<Rect> GetCoverage(const Matrix& transform) const override;
+
+ private:
+  std::vector<Rect> rects_;
+
+  FillRectsGeometry(const FillRectsGeometry&) = delete;
+
+  FillRectsGeometry& operator=(const FillRectsGeometry&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_FILL_RECTS_GEOMETRY_H_
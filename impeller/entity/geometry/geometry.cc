@@ -12,6 +12,7 @@
 #include "impeller/entity/geometry/cover_geometry.h"
 #include "impeller/entity/geometry/ellipse_geometry.h"
 #include "impeller/entity/geometry/fill_path_geometry.h"
+#include "impeller/entity/geometry/fill_rects_geometry.h"
 #include "impeller/entity/geometry/line_geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/rect_geometry.h"
@@ -59,8 +60,10 @@ GeometryResult::Mode Geometry::GetResultMode() const {
 
 std::shared_ptr<Geometry> Geometry::MakeFillPath(
     const Path& path,
-    std::optional<Rect> inner_rect) {
-  return std::make_shared<FillPathGeometry>(path, inner_rect);
+    std::optional<Rect> inner_rect,
+    bool retain_tessellation) {
+  return std::make_shared<FillPathGeometry>(path, inner_rect,
+                                            retain_tessellation);
 }
 
 std::shared_ptr<Geometry> Geometry::MakePointField(std::vector<Point> points,
@@ -90,6 +93,10 @@ std::shared_ptr<Geometry> Geometry::MakeRect(const Rect& rect) {
   return std::make_shared<RectGeometry>(rect);
 }
 
+std::shared_ptr<Geometry> Geometry::MakeFillRects(std::vector<Rect> rects) {
+  return std::make_shared<FillRectsGeometry>(std::move(rects));
+}
+
 std::shared_ptr<Geometry> Geometry::MakeOval(const Rect& rect) {
   return std::make_shared<EllipseGeometry>(rect);
 }
@@ -125,6 +132,10 @@ bool Geometry::IsAxisAlignedRect() const {
   return false;
 }
 
+std::optional<Rect> Geometry::AsFillRect() const {
+  return std::nullopt;
+}
+
 bool Geometry::CanApplyMaskFilter() const {
   return true;
 }
@@ -56,7 +56,8 @@ class Geometry {
  public:
   static std::shared_ptr<Geometry> MakeFillPath(
       const Path& path,
-      std::optional<Rect> inner_rect = std::nullopt);
+      std::optional<Rect> inner_rect = std::nullopt,
+      bool retain_tessellation = false);
 
   static std::shared_ptr<Geometry> MakeStrokePath(
       const Path& path,
@@ -69,6 +70,8 @@ class Geometry {
 
   static std::shared_ptr<Geometry> MakeRect(const Rect& rect);
 
+  static std::shared_ptr<Geometry> MakeFillRects(std::vector<Rect> rects);
+
   static std::shared_ptr<Geometry> MakeOval(const Rect& rect);
 
   static std::shared_ptr<Geometry> MakeLine(const Point& p0,
@@ -117,6 +120,11 @@ class Geometry {
 
   virtual bool IsAxisAlignedRect() const;
 
+  /// @brief    Returns the local space rectangle filled by this geometry if it
+  ///           is a plain rectangle whose vertices do not depend on the
+  ///           transform, or `std::nullopt` otherwise.
+  virtual std::optional<Rect> AsFillRect() const;
+
   virtual bool CanApplyMaskFilter() const;
 
   virtual Scalar ComputeAlphaCoverage(const Matrix& transform) const {
@@ -8,6 +8,7 @@
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/geometry/tessellation_cache.h"
 #include "impeller/geometry/constants.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
@@ -75,6 +76,25 @@ TEST(EntityGeometryTest, RectGeometryCoversArea) {
   ASSERT_TRUE(geometry->CoversArea({}, Rect()));
 }
 
+TEST(EntityGeometryTest, OnlyRectGeometryIsAFillRect) {
+  auto rect = Geometry::MakeRect(Rect::MakeLTRB(0, 0, 100, 100));
+  EXPECT_EQ(rect->AsFillRect(), Rect::MakeLTRB(0, 0, 100, 100));
+
+  auto line = Geometry::MakeLine({10, 10}, {20, 10}, 2, Cap::kButt);
+  EXPECT_FALSE(line->AsFillRect().has_value());
+}
+
+TEST(EntityGeometryTest, FillRectsGeometryCoverage) {
+  auto geometry = Geometry::MakeFillRects({Rect::MakeLTRB(0, 0, 10, 10),
+                                           Rect::MakeLTRB(20, 30, 40, 50)});
+  EXPECT_EQ(geometry->GetCoverage({}), Rect::MakeLTRB(0, 0, 40, 50));
+  EXPECT_EQ(geometry->GetCoverage(Matrix::MakeTranslation({5, 5})),
+            Rect::MakeLTRB(5, 5, 45, 55));
+  EXPECT_FALSE(geometry->AsFillRect().has_value());
+
+  EXPECT_FALSE(Geometry::MakeFillRects({})->GetCoverage({}).has_value());
+}
+
 TEST(EntityGeometryTest, FillPathGeometryCoversArea) {
   auto path = PathBuilder{}.AddRect(Rect::MakeLTRB(0, 0, 100, 100)).TakePath();
   auto geometry = Geometry::MakeFillPath(
@@ -152,5 +172,55 @@ TEST(EntityGeometryTest, AlphaCoverageStrokePaths) {
   EXPECT_EQ(Geometry::MakeStrokePath({}, 40)->ComputeAlphaCoverage(matrix), 1);
 }
 
+TEST(EntityGeometryTest, TessellationCacheReusesTessellationsOfSamePath) {
+  auto allocator = std::make_shared<::testing::NiceMock<MockAllocator>>();
+  EXPECT_CALL(*allocator, OnCreateBuffer)
+      .Times(2)
+      .WillRepeatedly([](const DeviceBufferDescriptor& desc) {
+        auto buffer =
+            std::make_shared<::testing::NiceMock<MockDeviceBuffer>>(desc);
+        ON_CALL(*buffer, OnCopyHostBuffer)
+            .WillByDefault(::testing::Return(true));
+        return buffer;
+      });
+  TessellationCache cache(allocator);
+
+  Path path = PathBuilder{}
+                  .AddRoundedRect(Rect::MakeLTRB(0, 0, 100, 100), 10)
+                  .TakePath();
+  Path copy = path;
+
+  // Paths are only cached once they are requested again.
+  EXPECT_FALSE(cache.TessellateConvex(path, 1.0f));
+  VertexBuffer first = cache.TessellateConvex(copy, 1.0f);
+  VertexBuffer second = cache.TessellateConvex(path, 1.0f);
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first.vertex_buffer.buffer, second.vertex_buffer.buffer);
+  EXPECT_EQ(first.vertex_count, second.vertex_count);
+  EXPECT_EQ(cache.GetEntryCountForTesting(), 1u);
+
+  // A different scale produces a different tessellation.
+  EXPECT_FALSE(cache.TessellateConvex(path, 2.0f));
+  VertexBuffer scaled = cache.TessellateConvex(path, 2.0f);
+  EXPECT_NE(first.vertex_buffer.buffer, scaled.vertex_buffer.buffer);
+  EXPECT_EQ(cache.GetEntryCountForTesting(), 2u);
+}
+
+TEST(EntityGeometryTest, TessellationCacheDoesNotRetainPathsRequestedOnce) {
+  auto allocator = std::make_shared<::testing::NiceMock<MockAllocator>>();
+  EXPECT_CALL(*allocator, OnCreateBuffer).Times(0);
+  TessellationCache cache(allocator);
+
+  // Paths that are rebuilt every frame never share their data, so they must
+  // neither allocate device buffers nor evict retained entries.
+  for (auto i = 0; i < 3; i++) {
+    Path path = PathBuilder{}
+                    .AddRoundedRect(Rect::MakeLTRB(0, 0, 100, 100), 10)
+                    .TakePath();
+    EXPECT_FALSE(cache.TessellateConvex(path, 1.0f));
+  }
+  EXPECT_EQ(cache.GetEntryCountForTesting(), 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -41,4 +41,8 @@ bool RectGeometry::IsAxisAlignedRect() const {
   return true;
 }
 
+std::optional<Rect> RectGeometry::AsFillRect() const {
+  return rect_;
+}
+
 }  // namespace impeller
@@ -21,6 +21,9 @@ class RectGeometry final : public Geometry {
   // |Geometry|
   bool IsAxisAlignedRect() const override;
 
+  // |Geometry|
+  std::optional<Rect> AsFillRect() const override;
+
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
                                    const Entity& entity,
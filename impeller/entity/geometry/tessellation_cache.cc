@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/geometry/tessellation_cache.h"
+
+#include <algorithm>
+
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/formats.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+TessellationCache::TessellationCache(std::shared_ptr<Allocator> allocator)
+    : allocator_(std::move(allocator)) {}
+
+TessellationCache::~TessellationCache() = default;
+
+VertexBuffer TessellationCache::TessellateConvex(const Path& path,
+                                                 Scalar scale) {
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->scale == scale && it->path.SharesDataWith(path)) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return entries_.front().vertex_buffer;
+    }
+  }
+
+  // Only cache paths that are requested again.
+  auto candidate = std::find_if(
+      candidates_.begin(), candidates_.end(), [&](const Candidate& entry) {
+        return entry.scale == scale && entry.path.SharesDataWith(path);
+      });
+  if (candidate == candidates_.end()) {
+    if (candidates_.size() >= kMaxEntries) {
+      candidates_.pop_back();
+    }
+    candidates_.push_front(Candidate{.path = path, .scale = scale});
+    return {};
+  }
+  candidates_.erase(candidate);
+
+  Tessellator::TessellateConvexInternal(path, point_buffer_, index_buffer_,
+                                        scale);
+  if (point_buffer_.empty() || !allocator_) {
+    return VertexBuffer{
+        .vertex_buffer = {},
+        .index_buffer = {},
+        .vertex_count = 0u,
+        .index_type = IndexType::k16bit,
+    };
+  }
+
+  // Points and indices share a single device buffer. The points come first so
+  // that both are suitably aligned.
+  const size_t points_length = sizeof(Point) * point_buffer_.size();
+  const size_t indices_length = sizeof(uint16_t) * index_buffer_.size();
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = points_length + indices_length;
+  std::shared_ptr<DeviceBuffer> buffer = allocator_->CreateBuffer(desc);
+  if (!buffer ||
+      !buffer->CopyHostBuffer(
+          reinterpret_cast<const uint8_t*>(point_buffer_.data()),
+          Range{0, points_length}, 0u) ||
+      !buffer->CopyHostBuffer(
+          reinterpret_cast<const uint8_t*>(index_buffer_.data()),
+          Range{0, indices_length}, points_length)) {
+    return {};
+  }
+
+  VertexBuffer vertex_buffer{
+      .vertex_buffer = {.buffer = buffer, .range = Range{0, points_length}},
+      .index_buffer = {.buffer = buffer,
+                       .range = Range{points_length, indices_length}},
+      .vertex_count = index_buffer_.size(),
+      .index_type = IndexType::k16bit,
+  };
+
+  if (entries_.size() >= kMaxEntries) {
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{
+      .path = path,
+      .scale = scale,
+      .vertex_buffer = vertex_buffer,
+  });
+  return vertex_buffer;
+}
+
+size_t TessellationCache::GetEntryCountForTesting() const {
+  return entries_.size();
+}
+
+}  // namespace impeller
@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "impeller/core/allocator.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/geometry/path.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A small LRU cache of convex tessellations for paths that are
+///             submitted again every frame, such as the clip paths of
+///             retained display lists.
+///
+///             Entries are keyed by path identity (see |Path::SharesDataWith|)
+///             and the tessellation scale. Unlike tessellations written to the
+///             per-frame host buffer, the vertices of cached entries live in
+///             device buffers owned by the cache and survive across frames.
+///
+///             A path is only tessellated into the cache once it is requested
+///             again, so that paths which are rebuilt every frame, like those
+///             of animated clips, neither allocate device buffers nor evict
+///             the entries of retained paths.
+///
+///             This class is not thread safe and should only be used from the
+///             raster thread.
+///
+class TessellationCache {
+ public:
+  static constexpr size_t kMaxEntries = 32u;
+
+  explicit TessellationCache(std::shared_ptr<Allocator> allocator);
+
+  ~TessellationCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Return the convex tessellation of the given path at the given
+  ///             scale, tessellating and caching it if it was requested
+  ///             before.
+  ///
+  /// @return     The vertex buffer, or an empty vertex buffer if the path was
+  ///             not requested before, has no vertices or the device buffer
+  ///             could not be allocated. The caller should then tessellate
+  ///             the path into the per-frame host buffer instead.
+  ///
+  VertexBuffer TessellateConvex(const Path& path, Scalar scale);
+
+  size_t GetEntryCountForTesting() const;
+
+ private:
+  struct Entry {
+    Path path;
+    Scalar scale;
+    VertexBuffer vertex_buffer;
+  };
+
+  struct Candidate {
+    Path path;
+    Scalar scale;
+  };
+
+  std::shared_ptr<Allocator> allocator_;
+  // Ordered from most to least recently used.
+  std::list<Entry> entries_;
+  // Paths that were requested once but not cached yet, ordered from most to
+  // least recently requested.
+  std::list<Candidate> candidates_;
+  std::vector<Point> point_buffer_;
+  std::vector<uint16_t> index_buffer_;
+
+  TessellationCache(const TessellationCache&) = delete;
+
+  TessellationCache& operator=(const TessellationCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_GEOMETRY_TESSELLATION_CACHE_H_
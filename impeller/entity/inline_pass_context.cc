@@ -73,9 +73,12 @@ bool InlinePassContext::EndPass() {
       return false;
     }
   }
+  // Defer submission so that all passes of a frame can be submitted to the
+  // GPU together. Any later submission on this thread, or the flush at the
+  // end of the frame, submits this command buffer first.
   if (!renderer_.GetContext()
            ->GetCommandQueue()
-           ->Submit({std::move(command_buffer_)})
+           ->Enqueue(std::move(command_buffer_))
            .ok()) {
     return false;
   }
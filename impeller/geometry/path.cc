@@ -60,6 +60,10 @@ bool Path::IsEmpty() const {
   return data_->points.empty();
 }
 
+bool Path::SharesDataWith(const Path& other) const {
+  return data_ == other.data_;
+}
+
 void Path::EnumerateComponents(
     const Applier<LinearPathComponent>& linear_applier,
     const Applier<QuadraticPathComponent>& quad_applier,
@@ -138,6 +138,14 @@ class Path {
 
   bool IsEmpty() const;
 
+  /// Whether this path and |other| are copies of the same path and therefore
+  /// share their underlying data.
+  ///
+  /// Unlike a component-wise comparison, this is a constant time check and is
+  /// suitable for identifying paths that are re-submitted every frame, such as
+  /// those held by retained display lists.
+  bool SharesDataWith(const Path& other) const;
+
   template <class T>
   using Applier = std::function<void(size_t index, const T& component)>;
   void EnumerateComponents(
@@ -249,6 +249,15 @@ struct RenderPassData {
 
   gl.Clear(clear_bits);
 
+  // The GL state derived from the pipeline, viewport and scissor only needs to
+  // be updated when it differs from that of the previous command. Consecutive
+  // commands frequently share all of it, and skipping the redundant calls
+  // saves significant driver overhead.
+  const PipelineGLES* bound_pipeline = nullptr;
+  uint32_t bound_stencil_reference = 0u;
+  std::optional<Viewport> bound_viewport;
+  std::optional<IRect> bound_scissor;
+
   for (const auto& command : commands) {
     if (command.instance_count != 1u) {
       VALIDATION_LOG << "GLES backend does not support instanced rendering.";
@@ -271,6 +280,7 @@ struct RenderPassData {
 #endif  // IMPELLER_DEBUG
 
     const auto& pipeline = PipelineGLES::Cast(*command.pipeline);
+    const bool pipeline_changed = &pipeline != bound_pipeline;
 
     const auto* color_attachment =
         pipeline.GetDescriptor().GetLegacyCompatibleColorAttachment();
@@ -283,24 +293,33 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Configure blending.
     ///
-    ConfigureBlending(gl, color_attachment);
+    if (pipeline_changed) {
+      ConfigureBlending(gl, color_attachment);
+    }
 
     //--------------------------------------------------------------------------
     /// Setup stencil.
     ///
-    ConfigureStencil(gl, pipeline.GetDescriptor(), command.stencil_reference);
+    if (pipeline_changed ||
+        command.stencil_reference != bound_stencil_reference) {
+      ConfigureStencil(gl, pipeline.GetDescriptor(),
+                       command.stencil_reference);
+      bound_stencil_reference = command.stencil_reference;
+    }
 
     //--------------------------------------------------------------------------
     /// Configure depth.
     ///
-    if (auto depth =
-            pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
-        depth.has_value()) {
-      gl.Enable(GL_DEPTH_TEST);
-      gl.DepthFunc(ToCompareFunction(depth->depth_compare));
-      gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
-    } else {
-      gl.Disable(GL_DEPTH_TEST);
+    if (pipeline_changed) {
+      if (auto depth =
+              pipeline.GetDescriptor().GetDepthStencilAttachmentDescriptor();
+          depth.has_value()) {
+        gl.Enable(GL_DEPTH_TEST);
+        gl.DepthFunc(ToCompareFunction(depth->depth_compare));
+        gl.DepthMask(depth->depth_write_enabled ? GL_TRUE : GL_FALSE);
+      } else {
+        gl.Disable(GL_DEPTH_TEST);
+      }
     }
 
     // Both the viewport and scissor are specified in framebuffer coordinates.
@@ -312,62 +331,76 @@ struct RenderPassData {
     /// Setup the viewport.
     ///
     const auto& viewport = command.viewport.value_or(pass_data.viewport);
-    gl.Viewport(viewport.rect.GetX(),  // x
-                target_size.height - viewport.rect.GetY() -
-                    viewport.rect.GetHeight(),  // y
-                viewport.rect.GetWidth(),       // width
-                viewport.rect.GetHeight()       // height
-    );
-    if (pass_data.depth_attachment) {
-      if (gl.DepthRangef.IsAvailable()) {
-        gl.DepthRangef(viewport.depth_range.z_near, viewport.depth_range.z_far);
-      } else {
-        gl.DepthRange(viewport.depth_range.z_near, viewport.depth_range.z_far);
+    if (!bound_viewport.has_value() || !(bound_viewport.value() == viewport)) {
+      gl.Viewport(viewport.rect.GetX(),  // x
+                  target_size.height - viewport.rect.GetY() -
+                      viewport.rect.GetHeight(),  // y
+                  viewport.rect.GetWidth(),       // width
+                  viewport.rect.GetHeight()       // height
+      );
+      if (pass_data.depth_attachment) {
+        if (gl.DepthRangef.IsAvailable()) {
+          gl.DepthRangef(viewport.depth_range.z_near,
+                         viewport.depth_range.z_far);
+        } else {
+          gl.DepthRange(viewport.depth_range.z_near,
+                        viewport.depth_range.z_far);
+        }
       }
+      bound_viewport = viewport;
     }
 
     //--------------------------------------------------------------------------
     /// Setup the scissor rect.
     ///
-    if (command.scissor.has_value()) {
-      const auto& scissor = command.scissor.value();
-      gl.Enable(GL_SCISSOR_TEST);
-      gl.Scissor(
-          scissor.GetX(),                                             // x
-          target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
-          scissor.GetWidth(),                                         // width
-          scissor.GetHeight()                                         // height
-      );
-    } else {
-      gl.Disable(GL_SCISSOR_TEST);
+    // The scissor test was disabled before the first command, which matches
+    // the initial empty `bound_scissor`.
+    if (command.scissor != bound_scissor) {
+      if (command.scissor.has_value()) {
+        const auto& scissor = command.scissor.value();
+        if (!bound_scissor.has_value()) {
+          gl.Enable(GL_SCISSOR_TEST);
+        }
+        gl.Scissor(
+            scissor.GetX(),                                             // x
+            target_size.height - scissor.GetY() - scissor.GetHeight(),  // y
+            scissor.GetWidth(),                                         // width
+            scissor.GetHeight()  // height
+        );
+      } else {
+        gl.Disable(GL_SCISSOR_TEST);
+      }
+      bound_scissor = command.scissor;
     }
 
-    //--------------------------------------------------------------------------
-    /// Setup culling.
-    ///
-    switch (pipeline.GetDescriptor().GetCullMode()) {
-      case CullMode::kNone:
-        gl.Disable(GL_CULL_FACE);
-        break;
-      case CullMode::kFrontFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_FRONT);
-        break;
-      case CullMode::kBackFace:
-        gl.Enable(GL_CULL_FACE);
-        gl.CullFace(GL_BACK);
-        break;
-    }
-    //--------------------------------------------------------------------------
-    /// Setup winding order.
-    ///
-    switch (pipeline.GetDescriptor().GetWindingOrder()) {
-      case WindingOrder::kClockwise:
-        gl.FrontFace(GL_CW);
-        break;
-      case WindingOrder::kCounterClockwise:
-        gl.FrontFace(GL_CCW);
-        break;
+    if (pipeline_changed) {
+      //------------------------------------------------------------------------
+      /// Setup culling.
+      ///
+      switch (pipeline.GetDescriptor().GetCullMode()) {
+        case CullMode::kNone:
+          gl.Disable(GL_CULL_FACE);
+          break;
+        case CullMode::kFrontFace:
+          gl.Enable(GL_CULL_FACE);
+          gl.CullFace(GL_FRONT);
+          break;
+        case CullMode::kBackFace:
+          gl.Enable(GL_CULL_FACE);
+          gl.CullFace(GL_BACK);
+          break;
+      }
+      //------------------------------------------------------------------------
+      /// Setup winding order.
+      ///
+      switch (pipeline.GetDescriptor().GetWindingOrder()) {
+        case WindingOrder::kClockwise:
+          gl.FrontFace(GL_CW);
+          break;
+        case WindingOrder::kCounterClockwise:
+          gl.FrontFace(GL_CCW);
+          break;
+      }
     }
 
     if (command.vertex_buffer.index_type == IndexType::kUnknown) {
@@ -400,8 +433,11 @@ struct RenderPassData {
     //--------------------------------------------------------------------------
     /// Bind the pipeline program.
     ///
-    if (!pipeline.BindProgram()) {
-      return false;
+    if (pipeline_changed) {
+      if (!pipeline.BindProgram()) {
+        return false;
+      }
+      bound_pipeline = &pipeline;
     }
 
     //--------------------------------------------------------------------------
@@ -464,13 +500,13 @@ struct RenderPassData {
     if (!vertex_desc_gles->UnbindVertexAttributes(gl)) {
       return false;
     }
+  }
 
-    //--------------------------------------------------------------------------
-    /// Unbind the program pipeline.
-    ///
-    if (!pipeline.UnbindProgram()) {
-      return false;
-    }
+  //----------------------------------------------------------------------------
+  /// Unbind the program pipeline.
+  ///
+  if (bound_pipeline && !bound_pipeline->UnbindProgram()) {
+    return false;
   }
 
   if (gl.DiscardFramebufferEXT.IsAvailable()) {
@@ -83,6 +83,9 @@ void mockGetIntegerv(GLenum name, int* value) {
     case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
       *value = 8;
       break;
+    case GL_MAX_TEXTURE_SIZE:
+      *value = 4096;
+      break;
     default:
       *value = 0;
       break;
@@ -163,6 +166,79 @@ void mockDeleteQueriesEXT(GLsizei size, const GLuint* queries) {
 static_assert(CheckSameSignature<decltype(mockDeleteQueriesEXT),  //
                                  decltype(glDeleteQueriesEXT)>::value);
 
+GLuint mockCreateShader(GLenum type) {
+  return 1u;
+}
+
+static_assert(CheckSameSignature<decltype(mockCreateShader),  //
+                                 decltype(glCreateShader)>::value);
+
+void mockGetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+  *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static_assert(CheckSameSignature<decltype(mockGetShaderiv),  //
+                                 decltype(glGetShaderiv)>::value);
+
+GLuint mockCreateProgram() {
+  return 1u;
+}
+
+static_assert(CheckSameSignature<decltype(mockCreateProgram),  //
+                                 decltype(glCreateProgram)>::value);
+
+GLboolean mockIsProgram(GLuint program) {
+  return GL_TRUE;
+}
+
+static_assert(CheckSameSignature<decltype(mockIsProgram),  //
+                                 decltype(glIsProgram)>::value);
+
+void mockGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+  *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+static_assert(CheckSameSignature<decltype(mockGetProgramiv),  //
+                                 decltype(glGetProgramiv)>::value);
+
+void mockUseProgram(GLuint program) {
+  RecordGLCall("glUseProgram");
+}
+
+static_assert(CheckSameSignature<decltype(mockUseProgram),  //
+                                 decltype(glUseProgram)>::value);
+
+void mockViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glViewport");
+}
+
+static_assert(CheckSameSignature<decltype(mockViewport),  //
+                                 decltype(glViewport)>::value);
+
+void mockScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  RecordGLCall("glScissor");
+}
+
+static_assert(CheckSameSignature<decltype(mockScissor),  //
+                                 decltype(glScissor)>::value);
+
+void mockStencilFuncSeparate(GLenum face,
+                             GLenum func,
+                             GLint ref,
+                             GLuint mask) {
+  RecordGLCall("glStencilFuncSeparate");
+}
+
+static_assert(CheckSameSignature<decltype(mockStencilFuncSeparate),  //
+                                 decltype(glStencilFuncSeparate)>::value);
+
+void mockDrawArrays(GLenum mode, GLint first, GLsizei count) {
+  RecordGLCall("glDrawArrays");
+}
+
+static_assert(CheckSameSignature<decltype(mockDrawArrays),  //
+                                 decltype(glDrawArrays)>::value);
+
 std::shared_ptr<MockGLES> MockGLES::Init(
     const std::optional<std::vector<const unsigned char*>>& extensions,
     const char* version_string,
@@ -202,6 +278,26 @@ const ProcTableGLES::Resolver kMockResolverGLES = [](const char* name) {
     return reinterpret_cast<void*>(mockGetQueryObjectui64vEXT);
   } else if (strcmp(name, "glGetQueryObjectuivEXT") == 0) {
     return reinterpret_cast<void*>(mockGetQueryObjectuivEXT);
+  } else if (strcmp(name, "glCreateShader") == 0) {
+    return reinterpret_cast<void*>(&mockCreateShader);
+  } else if (strcmp(name, "glGetShaderiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetShaderiv);
+  } else if (strcmp(name, "glCreateProgram") == 0) {
+    return reinterpret_cast<void*>(&mockCreateProgram);
+  } else if (strcmp(name, "glIsProgram") == 0) {
+    return reinterpret_cast<void*>(&mockIsProgram);
+  } else if (strcmp(name, "glGetProgramiv") == 0) {
+    return reinterpret_cast<void*>(&mockGetProgramiv);
+  } else if (strcmp(name, "glUseProgram") == 0) {
+    return reinterpret_cast<void*>(&mockUseProgram);
+  } else if (strcmp(name, "glViewport") == 0) {
+    return reinterpret_cast<void*>(&mockViewport);
+  } else if (strcmp(name, "glScissor") == 0) {
+    return reinterpret_cast<void*>(&mockScissor);
+  } else if (strcmp(name, "glStencilFuncSeparate") == 0) {
+    return reinterpret_cast<void*>(&mockStencilFuncSeparate);
+  } else if (strcmp(name, "glDrawArrays") == 0) {
+    return reinterpret_cast<void*>(&mockDrawArrays);
   } else {
     return reinterpret_cast<void*>(&doNothing);
   }
@@ -0,0 +1,195 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <optional>
+
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/renderer/backend/gles/context_gles.h"
+#include "impeller/renderer/backend/gles/texture_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+#include "impeller/renderer/command_buffer.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+#include "impeller/renderer/shader_library.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestWorker final : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+
+class RenderPassGLESTestHarness {
+ public:
+  RenderPassGLESTestHarness()
+      : mock_gles_(MockGLES::Init()),
+        worker_(std::make_shared<TestWorker>()) {
+    context_ = ContextGLES::Create(
+        std::make_unique<ProcTableGLES>(kMockResolverGLES), {},
+        /*enable_gpu_tracing=*/false);
+    context_->AddReactorWorker(worker_);
+
+    auto library = context_->GetShaderLibrary();
+    library->RegisterFunction(
+        "test", ShaderStage::kVertex,
+        std::make_shared<fml::DataMapping>("void main() {}"), {});
+    library->RegisterFunction(
+        "test", ShaderStage::kFragment,
+        std::make_shared<fml::DataMapping>("void main() {}"), {});
+
+    TextureDescriptor texture_desc;
+    texture_desc.format = PixelFormat::kR8G8B8A8UNormInt;
+    texture_desc.size = {100, 100};
+    texture_desc.usage = TextureUsage::kRenderTarget;
+    ColorAttachment color0;
+    color0.texture =
+        TextureGLES::WrapFBO(context_->GetReactor(), texture_desc, 0u);
+    color0.load_action = LoadAction::kClear;
+    color0.store_action = StoreAction::kStore;
+    render_target_.SetColorAttachment(color0, 0u);
+
+    vertex_buffer_ =
+        context_->GetResourceAllocator()->CreateBuffer(DeviceBufferDescriptor{
+            .storage_mode = StorageMode::kHostVisible,
+            .size = 1024,
+        });
+  }
+
+  std::shared_ptr<Pipeline<PipelineDescriptor>> MakePipeline(
+      CullMode cull_mode = CullMode::kNone) {
+    auto library = context_->GetShaderLibrary();
+    PipelineDescriptor desc;
+    desc.SetLabel("test");
+    desc.AddStageEntrypoint(
+        library->GetFunction("test_vertex_main", ShaderStage::kVertex));
+    desc.AddStageEntrypoint(
+        library->GetFunction("test_fragment_main", ShaderStage::kFragment));
+    desc.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+    desc.SetColorAttachmentDescriptor(
+        0u, ColorAttachmentDescriptor{
+                .format = PixelFormat::kR8G8B8A8UNormInt});
+    desc.SetStencilAttachmentDescriptors(StencilAttachmentDescriptor{});
+    desc.SetCullMode(cull_mode);
+    return context_->GetPipelineLibrary()->GetPipeline(desc).Get();
+  }
+
+  std::shared_ptr<RenderPass> CreateRenderPass() {
+    // Drop the calls made while creating the context and pipelines.
+    mock_gles_->GetCapturedCalls();
+    command_buffer_ = context_->CreateCommandBuffer();
+    return command_buffer_->CreateRenderPass(render_target_);
+  }
+
+  VertexBuffer GetVertexBuffer() const {
+    return VertexBuffer{
+        .vertex_buffer = BufferView{vertex_buffer_, Range(0, 1024)},
+        .vertex_count = 3,
+        .index_type = IndexType::kNone,
+    };
+  }
+
+  size_t CountCalls(const std::string& function) {
+    if (!captured_calls_.has_value()) {
+      captured_calls_ = mock_gles_->GetCapturedCalls();
+    }
+    return static_cast<size_t>(std::count(
+        captured_calls_->begin(), captured_calls_->end(), function));
+  }
+
+ private:
+  std::shared_ptr<MockGLES> mock_gles_;
+  std::shared_ptr<TestWorker> worker_;
+  std::shared_ptr<ContextGLES> context_;
+  RenderTarget render_target_;
+  std::shared_ptr<DeviceBuffer> vertex_buffer_;
+  std::shared_ptr<CommandBuffer> command_buffer_;
+  std::optional<std::vector<std::string>> captured_calls_;
+};
+
+}  // namespace
+
+TEST(RenderPassGLES, SkipsRedundantStateForConsecutiveDraws) {
+  RenderPassGLESTestHarness harness;
+  auto pipeline = harness.MakePipeline();
+  ASSERT_TRUE(pipeline && pipeline->IsValid());
+
+  auto render_pass = harness.CreateRenderPass();
+  ASSERT_TRUE(render_pass && render_pass->IsValid());
+  for (auto i = 0; i < 3; i++) {
+    render_pass->SetPipeline(pipeline);
+    render_pass->SetStencilReference(1u);
+    render_pass->SetScissor(IRect::MakeXYWH(0, 0, 10, 10));
+    ASSERT_TRUE(render_pass->SetVertexBuffer(harness.GetVertexBuffer()));
+    ASSERT_TRUE(render_pass->Draw().ok());
+  }
+  ASSERT_TRUE(render_pass->EncodeCommands());
+
+  EXPECT_EQ(harness.CountCalls("glDrawArrays"), 3u);
+  // The program is bound once and unbound at the end of the pass.
+  EXPECT_EQ(harness.CountCalls("glUseProgram"), 2u);
+  EXPECT_EQ(harness.CountCalls("glViewport"), 1u);
+  EXPECT_EQ(harness.CountCalls("glScissor"), 1u);
+  EXPECT_EQ(harness.CountCalls("glStencilFuncSeparate"), 1u);
+}
+
+TEST(RenderPassGLES, ReissuesStateWhenItChanges) {
+  RenderPassGLESTestHarness harness;
+  auto pipeline = harness.MakePipeline();
+  ASSERT_TRUE(pipeline && pipeline->IsValid());
+  auto culling_pipeline = harness.MakePipeline(CullMode::kBackFace);
+  ASSERT_TRUE(culling_pipeline && culling_pipeline->IsValid());
+  ASSERT_NE(pipeline, culling_pipeline);
+
+  auto render_pass = harness.CreateRenderPass();
+  ASSERT_TRUE(render_pass && render_pass->IsValid());
+
+  render_pass->SetPipeline(pipeline);
+  render_pass->SetStencilReference(0u);
+  render_pass->SetScissor(IRect::MakeXYWH(0, 0, 10, 10));
+  ASSERT_TRUE(render_pass->SetVertexBuffer(harness.GetVertexBuffer()));
+  ASSERT_TRUE(render_pass->Draw().ok());
+
+  // A new stencil reference, scissor and viewport for the same pipeline.
+  render_pass->SetPipeline(pipeline);
+  render_pass->SetStencilReference(1u);
+  render_pass->SetScissor(IRect::MakeXYWH(10, 10, 20, 20));
+  render_pass->SetViewport(Viewport{.rect = Rect::MakeXYWH(0, 0, 50, 50)});
+  ASSERT_TRUE(render_pass->SetVertexBuffer(harness.GetVertexBuffer()));
+  ASSERT_TRUE(render_pass->Draw().ok());
+
+  // A new pipeline with the same stencil reference, scissor and viewport.
+  render_pass->SetPipeline(culling_pipeline);
+  render_pass->SetStencilReference(1u);
+  render_pass->SetScissor(IRect::MakeXYWH(10, 10, 20, 20));
+  render_pass->SetViewport(Viewport{.rect = Rect::MakeXYWH(0, 0, 50, 50)});
+  ASSERT_TRUE(render_pass->SetVertexBuffer(harness.GetVertexBuffer()));
+  ASSERT_TRUE(render_pass->Draw().ok());
+
+  ASSERT_TRUE(render_pass->EncodeCommands());
+
+  EXPECT_EQ(harness.CountCalls("glDrawArrays"), 3u);
+  // Two binds plus the unbind at the end of the pass.
+  EXPECT_EQ(harness.CountCalls("glUseProgram"), 3u);
+  // The stencil state is derived from the pipeline, so both a new reference
+  // and a new pipeline configure it again.
+  EXPECT_EQ(harness.CountCalls("glStencilFuncSeparate"), 3u);
+  EXPECT_EQ(harness.CountCalls("glViewport"), 2u);
+  EXPECT_EQ(harness.CountCalls("glScissor"), 2u);
+}
+
+}  // namespace testing
+}  // namespace impeller
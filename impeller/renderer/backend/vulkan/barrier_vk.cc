@@ -4,4 +4,34 @@
 
 #include "impeller/renderer/backend/vulkan/barrier_vk.h"
 
-namespace impeller {}  // namespace impeller
+namespace impeller {
+
+void ImageBarriersVK::Add(const vk::ImageMemoryBarrier& image_barrier,
+                          vk::PipelineStageFlags src_stage,
+                          vk::PipelineStageFlags dst_stage) {
+  image_barriers_.push_back(image_barrier);
+  src_stage_ |= src_stage;
+  dst_stage_ |= dst_stage;
+}
+
+bool ImageBarriersVK::IsEmpty() const {
+  return image_barriers_.empty();
+}
+
+void ImageBarriersVK::Encode(const vk::CommandBuffer& cmd_buffer) {
+  if (image_barriers_.empty()) {
+    return;
+  }
+  cmd_buffer.pipelineBarrier(src_stage_,       // src stage
+                             dst_stage_,       // dst stage
+                             {},               // dependency flags
+                             nullptr,          // memory barriers
+                             nullptr,          // buffer barriers
+                             image_barriers_   // image barriers
+  );
+  image_barriers_.clear();
+  src_stage_ = {};
+  dst_stage_ = {};
+}
+
+}  // namespace impeller
@@ -5,6 +5,8 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
 
+#include <vector>
+
 #include "impeller/renderer/backend/vulkan/vk.h"
 
 namespace impeller {
@@ -49,6 +51,35 @@ struct BarrierVK {
   vk::AccessFlags dst_access = vk::AccessFlagBits::eNone;
 };
 
+//------------------------------------------------------------------------------
+/// @brief      Collects image memory barriers so that transitions of several
+///             images (or subresources) can be encoded with a single
+///             `vkCmdPipelineBarrier`.
+///
+///             The stage masks of the encoded barrier are the union of the
+///             stage masks of the collected barriers. This never synchronizes
+///             less than encoding each barrier on its own.
+///
+class ImageBarriersVK {
+ public:
+  void Add(const vk::ImageMemoryBarrier& image_barrier,
+           vk::PipelineStageFlags src_stage,
+           vk::PipelineStageFlags dst_stage);
+
+  bool IsEmpty() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode all collected barriers to `cmd_buffer` and reset the
+  ///             collection. Nothing is encoded if the collection is empty.
+  ///
+  void Encode(const vk::CommandBuffer& cmd_buffer);
+
+ private:
+  std::vector<vk::ImageMemoryBarrier> image_barriers_;
+  vk::PipelineStageFlags src_stage_ = {};
+  vk::PipelineStageFlags dst_stage_ = {};
+};
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_BARRIER_VK_H_
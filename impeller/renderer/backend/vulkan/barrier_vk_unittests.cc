@@ -0,0 +1,52 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/renderer/backend/vulkan/barrier_vk.h"
+#include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(ImageBarriersVKTest, EncodesAllBarriersWithOnePipelineBarrier) {
+  auto const context = MockVulkanContextBuilder().Build();
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  auto count_barriers = [&functions]() {
+    return std::count(functions->begin(), functions->end(),
+                      "vkCmdPipelineBarrier");
+  };
+
+  auto buffer = context->CreateCommandBuffer();
+  const vk::CommandBuffer& cmd_buffer =
+      CommandBufferVK::Cast(*buffer).GetEncoder()->GetCommandBuffer();
+
+  ImageBarriersVK barriers;
+  EXPECT_TRUE(barriers.IsEmpty());
+
+  vk::ImageMemoryBarrier image_barrier;
+  image_barrier.oldLayout = vk::ImageLayout::eUndefined;
+  image_barrier.newLayout = vk::ImageLayout::eGeneral;
+  barriers.Add(image_barrier, vk::PipelineStageFlagBits::eFragmentShader,
+               vk::PipelineStageFlagBits::eColorAttachmentOutput);
+  barriers.Add(image_barrier, vk::PipelineStageFlagBits::eTransfer,
+               vk::PipelineStageFlagBits::eTransfer);
+  EXPECT_FALSE(barriers.IsEmpty());
+
+  const auto initial_barriers = count_barriers();
+  barriers.Encode(cmd_buffer);
+  EXPECT_EQ(count_barriers(), initial_barriers + 1);
+  EXPECT_TRUE(barriers.IsEmpty());
+
+  // Encoding an empty collection records nothing.
+  barriers.Encode(cmd_buffer);
+  EXPECT_EQ(count_barriers(), initial_barriers + 1);
+}
+
+}  // namespace testing
+}  // namespace impeller
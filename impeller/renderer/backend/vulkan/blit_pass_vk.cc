@@ -107,10 +107,13 @@ bool BlitPassVK::OnCopyTextureToTextureCommand(
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  ImageBarriersVK barriers;
+  if (!src.SetLayout(src_barrier, barriers) ||
+      !dst.SetLayout(dst_barrier, barriers)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
+  barriers.Encode(cmd_buffer);
 
   vk::ImageCopy image_copy;
 
@@ -354,10 +357,13 @@ bool BlitPassVK::ResizeTexture(const std::shared_ptr<Texture>& source,
   dst_barrier.dst_stage = vk::PipelineStageFlagBits::eFragmentShader |
                           vk::PipelineStageFlagBits::eTransfer;
 
-  if (!src.SetLayout(src_barrier) || !dst.SetLayout(dst_barrier)) {
+  ImageBarriersVK barriers;
+  if (!src.SetLayout(src_barrier, barriers) ||
+      !dst.SetLayout(dst_barrier, barriers)) {
     VALIDATION_LOG << "Could not complete layout transitions.";
     return false;
   }
+  barriers.Encode(cmd_buffer);
 
   vk::ImageBlit blit;
   blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
@@ -451,6 +457,10 @@ bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
   barrier.subresourceRange.layerCount = 1;
   barrier.subresourceRange.levelCount = 1;
 
+  // Transitions of different mip levels that are separated by no other
+  // commands are collected and encoded with a single pipeline barrier.
+  ImageBarriersVK barriers;
+
   // Blit from the mip level N - 1 to mip level N.
   size_t width = size.width;
   size_t height = size.height;
@@ -464,10 +474,11 @@ bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
     // We just finished writing to the previous (N-1) mip level or it was the
     // base mip level. These were initialized to TransferDst earler. We are now
     // going to read from it to write to the current level (N) . So it must be
-    // converted to TransferSrc.
-    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                        vk::PipelineStageFlagBits::eTransfer, {}, {}, {},
-                        {barrier});
+    // converted to TransferSrc. This is encoded together with the transition
+    // of level N-2 to ShaderReadOnly from the previous iteration.
+    barriers.Add(barrier, vk::PipelineStageFlagBits::eTransfer,
+                 vk::PipelineStageFlagBits::eTransfer);
+    barriers.Encode(cmd);
 
     vk::ImageBlit blit;
     blit.srcSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
@@ -510,9 +521,8 @@ bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
     // Now that the blit is done, the image at the previous level (N-1)
     // is done reading from (TransferSrc)/ Now we must prepare it to be read
     // from a shader (ShaderReadOnly).
-    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                        vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {},
-                        {barrier});
+    barriers.Add(barrier, vk::PipelineStageFlagBits::eTransfer,
+                 vk::PipelineStageFlagBits::eFragmentShader);
   }
 
   barrier.subresourceRange.baseMipLevel = mip_count - 1;
@@ -521,9 +531,9 @@ bool BlitPassVK::OnGenerateMipmapCommand(std::shared_ptr<Texture> texture,
   barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
   barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
 
-  cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                      vk::PipelineStageFlagBits::eFragmentShader, {}, {}, {},
-                      {barrier});
+  barriers.Add(barrier, vk::PipelineStageFlagBits::eTransfer,
+               vk::PipelineStageFlagBits::eFragmentShader);
+  barriers.Encode(cmd);
 
   // We modified the layouts of this image from underneath it. Tell it its new
   // state so it doesn't try to perform redundant transitions under the hood.
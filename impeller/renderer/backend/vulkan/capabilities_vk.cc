@@ -202,6 +202,8 @@ static const char* GetExtensionName(OptionalDeviceExtensionVK ext) {
       return "VK_KHR_portability_subset";
     case OptionalDeviceExtensionVK::kEXTImageCompressionControl:
       return VK_EXT_IMAGE_COMPRESSION_CONTROL_EXTENSION_NAME;
+    case OptionalDeviceExtensionVK::kKHRPushDescriptor:
+      return VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME;
     case OptionalDeviceExtensionVK::kLast:
       return "Unknown";
   }
@@ -465,6 +467,18 @@ void CapabilitiesVK::SetOffscreenFormat(PixelFormat pixel_format) const {
   default_color_format_ = pixel_format;
 }
 
+bool CapabilitiesVK::SupportsPushDescriptors() const {
+  return HasExtension(OptionalDeviceExtensionVK::kKHRPushDescriptor);
+}
+
+bool CapabilitiesVK::IsCPUDevice() const {
+  return device_properties_.deviceType == vk::PhysicalDeviceType::eCpu;
+}
+
+void CapabilitiesVK::SetSupportsOffscreenMSAA(bool value) {
+  supports_offscreen_msaa_ = value;
+}
+
 bool CapabilitiesVK::SetPhysicalDevice(
     const vk::PhysicalDevice& device,
     const PhysicalDeviceFeatures& enabled_features) {
@@ -563,7 +577,7 @@ bool CapabilitiesVK::SetPhysicalDevice(
 
 // |Capabilities|
 bool CapabilitiesVK::SupportsOffscreenMSAA() const {
-  return true;
+  return supports_offscreen_msaa_;
 }
 
 // |Capabilities|
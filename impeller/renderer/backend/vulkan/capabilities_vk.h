@@ -140,6 +140,14 @@ enum class OptionalDeviceExtensionVK : uint32_t {
   ///
   kEXTImageCompressionControl,
 
+  //----------------------------------------------------------------------------
+  /// To record descriptor updates directly into command buffers instead of
+  /// allocating and writing descriptor sets for every draw.
+  ///
+  /// https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_push_descriptor.html
+  ///
+  kKHRPushDescriptor,
+
   kLast,
 };
 
@@ -208,6 +216,14 @@ class CapabilitiesVK final : public Capabilities,
 
   void SetOffscreenFormat(PixelFormat pixel_format) const;
 
+  //----------------------------------------------------------------------------
+  /// @return     If the physical device is a CPU implementation of Vulkan,
+  ///             such as SwiftShader.
+  ///
+  bool IsCPUDevice() const;
+
+  void SetSupportsOffscreenMSAA(bool value);
+
   // |Capabilities|
   bool SupportsOffscreenMSAA() const override;
 
@@ -256,6 +272,12 @@ class CapabilitiesVK final : public Capabilities,
   ///
   bool SupportsTextureFixedRateCompression() const;
 
+  //----------------------------------------------------------------------------
+  /// @return     If descriptors can be pushed directly into command buffers
+  ///             via VK_KHR_push_descriptor.
+  ///
+  bool SupportsPushDescriptors() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Get the fixed compression rate supported by the context for
   ///             the given format and usage.
@@ -281,6 +303,7 @@ class CapabilitiesVK final : public Capabilities,
   PixelFormat default_depth_stencil_format_ = PixelFormat::kUnknown;
   vk::PhysicalDevice physical_device_;
   vk::PhysicalDeviceProperties device_properties_;
+  bool supports_offscreen_msaa_ = true;
   bool supports_compute_subgroups_ = false;
   bool supports_device_transient_textures_ = false;
   bool supports_texture_fixed_rate_compression_ = false;
@@ -28,6 +28,49 @@ fml::Status CommandQueueVK::Submit(
     return fml::Status(fml::StatusCode::kInvalidArgument,
                        "No command buffers provided.");
   }
+  // Any work enqueued earlier on this thread may be a dependency of these
+  // buffers (for example, an offscreen pass sampled by a filter). Submit it
+  // first as part of the same batch.
+  PendingBuffers pending = TakePendingBuffers();
+  if (pending.empty()) {
+    return SubmitBuffers(buffers, completion_callback);
+  }
+  pending.insert(pending.end(), buffers.begin(), buffers.end());
+  return SubmitBuffers(pending, completion_callback);
+}
+
+fml::Status CommandQueueVK::Enqueue(std::shared_ptr<CommandBuffer> buffer) {
+  if (!buffer) {
+    return fml::Status(fml::StatusCode::kInvalidArgument,
+                       "No command buffer provided.");
+  }
+  Lock lock(pending_mutex_);
+  pending_buffers_[std::this_thread::get_id()].push_back(std::move(buffer));
+  return fml::Status();
+}
+
+fml::Status CommandQueueVK::Flush() {
+  PendingBuffers pending = TakePendingBuffers();
+  if (pending.empty()) {
+    return fml::Status();
+  }
+  return SubmitBuffers(pending, {});
+}
+
+CommandQueueVK::PendingBuffers CommandQueueVK::TakePendingBuffers() {
+  Lock lock(pending_mutex_);
+  auto found = pending_buffers_.find(std::this_thread::get_id());
+  if (found == pending_buffers_.end()) {
+    return {};
+  }
+  PendingBuffers pending = std::move(found->second);
+  pending_buffers_.erase(found);
+  return pending;
+}
+
+fml::Status CommandQueueVK::SubmitBuffers(
+    const PendingBuffers& buffers,
+    const CompletionCallback& completion_callback) {
   // Success or failure, you only get to submit once.
   fml::ScopedCleanupClosure reset([&]() {
     if (completion_callback) {
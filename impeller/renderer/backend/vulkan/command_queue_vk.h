@@ -5,6 +5,11 @@
 #ifndef FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_COMMAND_QUEUE_VK_H_
 #define FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_COMMAND_QUEUE_VK_H_
 
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/base/thread.h"
 #include "impeller/renderer/command_queue.h"
 
 namespace impeller {
@@ -21,8 +26,26 @@ class CommandQueueVK : public CommandQueue {
       const std::vector<std::shared_ptr<CommandBuffer>>& buffers,
       const CompletionCallback& completion_callback = {}) override;
 
+  // |CommandQueue|
+  fml::Status Enqueue(std::shared_ptr<CommandBuffer> buffer) override;
+
+  // |CommandQueue|
+  fml::Status Flush() override;
+
  private:
+  using PendingBuffers = std::vector<std::shared_ptr<CommandBuffer>>;
+
   std::weak_ptr<ContextVK> context_;
+  // Command buffers are recorded from thread local command pools, so pending
+  // buffers may only be ended and submitted by the thread that enqueued them.
+  Mutex pending_mutex_;
+  std::unordered_map<std::thread::id, PendingBuffers> pending_buffers_
+      IPLR_GUARDED_BY(pending_mutex_);
+
+  PendingBuffers TakePendingBuffers();
+
+  fml::Status SubmitBuffers(const PendingBuffers& buffers,
+                            const CompletionCallback& completion_callback);
 
   CommandQueueVK(const CommandQueueVK&) = delete;
 
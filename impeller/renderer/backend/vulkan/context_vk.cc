@@ -333,6 +333,10 @@ void ContextVK::Setup(Settings settings) {
     return;
   }
 
+  if (settings.disable_msaa_on_cpu_devices && caps->IsCPUDevice()) {
+    caps->SetSupportsOffscreenMSAA(false);
+  }
+
   //----------------------------------------------------------------------------
   /// Create the allocator.
   ///
@@ -52,6 +52,11 @@ class ContextVK final : public Context,
     bool disable_surface_control = false;
     /// If validations are requested but cannot be enabled, log a fatal error.
     bool fatal_missing_validations = false;
+    /// Render offscreen passes without MSAA when the physical device is a CPU
+    /// implementation such as SwiftShader. Every multisampled pass costs
+    /// about four times the fragment work plus a resolve on such devices, so
+    /// headless renderers may prefer aliased path edges over that cost.
+    bool disable_msaa_on_cpu_devices = false;
 
     Settings() = default;
 
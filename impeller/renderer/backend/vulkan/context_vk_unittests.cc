@@ -6,6 +6,7 @@
 #include "flutter/testing/testing.h"  // IWYU pragma: keep
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/renderer/backend/vulkan/capabilities_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
@@ -241,5 +242,76 @@ TEST(ContextVKTest, HasDefaultColorFormat) {
   ASSERT_NE(capabilites_vk->GetDefaultColorFormat(), PixelFormat::kUnknown);
 }
 
+TEST(ContextVKTest, EnqueuedCommandBuffersAreSubmittedInOneBatch) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  auto count_fences = [&functions]() {
+    return std::count(functions->begin(), functions->end(), "vkCreateFence");
+  };
+  const auto initial_fences = count_fences();
+
+  auto queue = context->GetCommandQueue();
+  ASSERT_TRUE(queue->Enqueue(context->CreateCommandBuffer()).ok());
+  ASSERT_TRUE(queue->Enqueue(context->CreateCommandBuffer()).ok());
+  EXPECT_EQ(count_fences(), initial_fences);
+
+  // Submitting on the same thread picks up the pending buffers too.
+  ASSERT_TRUE(queue->Submit({context->CreateCommandBuffer()}).ok());
+  EXPECT_EQ(count_fences(), initial_fences + 1);
+
+  // Nothing is left to flush.
+  ASSERT_TRUE(queue->Flush().ok());
+  EXPECT_EQ(count_fences(), initial_fences + 1);
+
+  ASSERT_TRUE(queue->Enqueue(context->CreateCommandBuffer()).ok());
+  ASSERT_TRUE(queue->Flush().ok());
+  EXPECT_EQ(count_fences(), initial_fences + 2);
+}
+
+TEST(CapabilitiesVKTest, SupportsPushDescriptorsWithExtension) {
+  std::shared_ptr<ContextVK> context = MockVulkanContextBuilder().Build();
+  EXPECT_FALSE(CapabilitiesVK::Cast(*context->GetCapabilities())
+                   .SupportsPushDescriptors());
+
+  context = MockVulkanContextBuilder()
+                .SetDeviceExtensions(
+                    {"VK_KHR_swapchain", "VK_KHR_push_descriptor"})
+                .Build();
+  EXPECT_TRUE(CapabilitiesVK::Cast(*context->GetCapabilities())
+                  .SupportsPushDescriptors());
+}
+
+TEST(CapabilitiesVKTest, CanDisableOffscreenMSAAOnCPUDevices) {
+  auto cpu_device_properties = [](VkPhysicalDevice device,
+                                   VkPhysicalDeviceProperties* prop) {
+    prop->deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+  };
+
+  std::shared_ptr<ContextVK> context =
+      MockVulkanContextBuilder()
+          .SetPhysicalPropertiesCallback(cpu_device_properties)
+          .Build();
+  EXPECT_TRUE(CapabilitiesVK::Cast(*context->GetCapabilities()).IsCPUDevice());
+  EXPECT_TRUE(context->GetCapabilities()->SupportsOffscreenMSAA());
+
+  context = MockVulkanContextBuilder()
+                .SetSettingsCallback([](auto& settings) {
+                  settings.disable_msaa_on_cpu_devices = true;
+                })
+                .SetPhysicalPropertiesCallback(cpu_device_properties)
+                .Build();
+  EXPECT_FALSE(context->GetCapabilities()->SupportsOffscreenMSAA());
+
+  // Hardware devices are unaffected by the setting.
+  context = MockVulkanContextBuilder()
+                .SetSettingsCallback([](auto& settings) {
+                  settings.disable_msaa_on_cpu_devices = true;
+                })
+                .Build();
+  EXPECT_FALSE(
+      CapabilitiesVK::Cast(*context->GetCapabilities()).IsCPUDevice());
+  EXPECT_TRUE(context->GetCapabilities()->SupportsOffscreenMSAA());
+}
+
 }  // namespace testing
 }  // namespace impeller
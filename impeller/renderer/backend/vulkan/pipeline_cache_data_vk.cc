@@ -12,6 +12,8 @@ namespace impeller {
 
 static constexpr const char* kPipelineCacheFileName =
     "flutter.impeller.vkcache";
+static constexpr const char* kPipelineUsageProfileFileName =
+    "flutter.impeller.vkcache.usage";
 
 bool PipelineCacheDataPersist(const fml::UniqueFD& cache_directory,
                               const VkPhysicalDeviceProperties& props,
@@ -91,6 +93,33 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
       on_disk_header.data_size, [on_disk_data](auto, auto) {});
 }
 
+bool PipelineUsageProfilePersist(const fml::UniqueFD& cache_directory,
+                                 const fml::Mapping& profile) {
+  if (!cache_directory.is_valid()) {
+    return false;
+  }
+  if (!fml::WriteAtomically(cache_directory, kPipelineUsageProfileFileName,
+                            profile)) {
+    VALIDATION_LOG << "Could not write pipeline usage profile to disk.";
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageProfileRetrieve(
+    const fml::UniqueFD& cache_directory) {
+  if (!cache_directory.is_valid()) {
+    return nullptr;
+  }
+  std::unique_ptr<fml::FileMapping> on_disk_data =
+      fml::FileMapping::CreateReadOnly(cache_directory,
+                                       kPipelineUsageProfileFileName);
+  if (!on_disk_data || on_disk_data->GetSize() == 0u) {
+    return nullptr;
+  }
+  return on_disk_data;
+}
+
 PipelineCacheHeaderVK::PipelineCacheHeaderVK() = default;
 
 PipelineCacheHeaderVK::PipelineCacheHeaderVK(
@@ -104,6 +104,28 @@ std::unique_ptr<fml::Mapping> PipelineCacheDataRetrieve(
     const fml::UniqueFD& cache_directory,
     const VkPhysicalDeviceProperties& props);
 
+//------------------------------------------------------------------------------
+/// @brief      Persist the pipeline usage profile to a file in the given cache
+///             directory, next to the pipeline cache.
+///
+/// @param[in]  cache_directory  The cache directory
+/// @param[in]  profile          The opaque usage profile data
+///
+/// @return     If the profile could be persisted to disk.
+///
+bool PipelineUsageProfilePersist(const fml::UniqueFD& cache_directory,
+                                 const fml::Mapping& profile);
+
+//------------------------------------------------------------------------------
+/// @brief      Retrieve the previously persisted pipeline usage profile.
+///
+/// @param[in]  cache_directory  The cache directory
+///
+/// @return     The profile data if one was found.
+///
+std::unique_ptr<fml::Mapping> PipelineUsageProfileRetrieve(
+    const fml::UniqueFD& cache_directory);
+
 }  // namespace impeller
 
 #endif  // FLUTTER_IMPELLER_RENDERER_BACKEND_VULKAN_PIPELINE_CACHE_DATA_VK_H_
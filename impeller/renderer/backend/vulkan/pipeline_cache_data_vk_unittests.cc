@@ -4,6 +4,7 @@
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
 #include "impeller/renderer/backend/vulkan/capabilities_vk.h"
@@ -92,6 +93,42 @@ TEST(PipelineCacheDataVKTest, CanCreateFromDeviceProperties) {
   }
 }
 
+TEST(PipelineCacheDataVKTest, CanPersistAndRetrieveUsageProfile) {
+  fml::ScopedTemporaryDirectory temp_dir;
+  EXPECT_EQ(PipelineUsageProfileRetrieve(temp_dir.fd()), nullptr);
+
+  const std::string profile = "impeller-pipeline-usage-v1\nsolid 1\n";
+  ASSERT_TRUE(PipelineUsageProfilePersist(temp_dir.fd(),
+                                          fml::DataMapping(profile)));
+  auto mapping = PipelineUsageProfileRetrieve(temp_dir.fd());
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(mapping->GetMapping()),
+                        mapping->GetSize()),
+            profile);
+
+  // A newer profile replaces the old one.
+  const std::string newer = "impeller-pipeline-usage-v1\n";
+  ASSERT_TRUE(
+      PipelineUsageProfilePersist(temp_dir.fd(), fml::DataMapping(newer)));
+  mapping = PipelineUsageProfileRetrieve(temp_dir.fd());
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(mapping->GetSize(), newer.size());
+}
+
+TEST(PipelineCacheDataVKTest, UsageProfileRequiresCacheDirectory) {
+  fml::UniqueFD invalid;
+  EXPECT_FALSE(PipelineUsageProfilePersist(
+      invalid, fml::DataMapping(std::string("profile"))));
+  EXPECT_EQ(PipelineUsageProfileRetrieve(invalid), nullptr);
+
+  // Empty profiles are treated as missing.
+  fml::ScopedTemporaryDirectory temp_dir;
+  ASSERT_TRUE(fml::OpenFile(temp_dir.fd(), "flutter.impeller.vkcache.usage",
+                            true, fml::FilePermission::kReadWrite)
+                  .is_valid());
+  EXPECT_EQ(PipelineUsageProfileRetrieve(temp_dir.fd()), nullptr);
+}
+
 using PipelineCacheDataVKPlaygroundTest = PlaygroundTest;
 INSTANTIATE_VULKAN_PLAYGROUND_SUITE(PipelineCacheDataVKPlaygroundTest);
 
@@ -118,6 +118,15 @@ void PipelineCacheVK::PersistCacheToDisk() const {
   );
 }
 
+std::unique_ptr<fml::Mapping> PipelineCacheVK::RetrieveUsageProfile() const {
+  return PipelineUsageProfileRetrieve(cache_directory_);
+}
+
+void PipelineCacheVK::PersistUsageProfileToDisk(
+    const fml::Mapping& profile) const {
+  PipelineUsageProfilePersist(cache_directory_, profile);
+}
+
 const CapabilitiesVK* PipelineCacheVK::GetCapabilities() const {
   return CapabilitiesVK::Cast(caps_.get());
 }
@@ -33,6 +33,10 @@ class PipelineCacheVK {
 
   void PersistCacheToDisk() const;
 
+  std::unique_ptr<fml::Mapping> RetrieveUsageProfile() const;
+
+  void PersistUsageProfileToDisk(const fml::Mapping& profile) const;
+
  private:
   const std::shared_ptr<const Capabilities> caps_;
   std::weak_ptr<DeviceHolderVK> device_holder_;
@@ -39,6 +39,11 @@ PipelineLibraryVK::PipelineLibraryVK(
     return;
   }
 
+  {
+    Lock lock(usage_profile_mutex_);
+    usage_profile_ = pso_cache_->RetrieveUsageProfile();
+  }
+
   is_valid_ = true;
 }
 
@@ -276,6 +281,7 @@ void PipelineLibraryVK::DidAcquireSurfaceFrame() {
       cache_dirty_ = false;
       PersistPipelineCacheToDisk();
     }
+    PersistUsageProfileToDiskIfNeeded();
     frames_acquired_ = 0;
   }
 }
@@ -291,6 +297,41 @@ void PipelineLibraryVK::PersistPipelineCacheToDisk() {
       });
 }
 
+// |PipelineLibrary|
+std::shared_ptr<const fml::Mapping> PipelineLibraryVK::GetUsageProfile() const {
+  Lock lock(usage_profile_mutex_);
+  return usage_profile_;
+}
+
+// |PipelineLibrary|
+void PipelineLibraryVK::SetUsageProfile(
+    std::shared_ptr<const fml::Mapping> profile) {
+  Lock lock(usage_profile_mutex_);
+  usage_profile_ = std::move(profile);
+  usage_profile_dirty_ = true;
+}
+
+void PipelineLibraryVK::PersistUsageProfileToDiskIfNeeded() {
+  std::shared_ptr<const fml::Mapping> profile;
+  {
+    Lock lock(usage_profile_mutex_);
+    if (!usage_profile_dirty_ || !usage_profile_) {
+      return;
+    }
+    usage_profile_dirty_ = false;
+    profile = usage_profile_;
+  }
+  worker_task_runner_->PostTask(
+      [weak_cache = decltype(pso_cache_)::weak_type(pso_cache_),
+       profile = std::move(profile)]() {
+        auto cache = weak_cache.lock();
+        if (!cache) {
+          return;
+        }
+        cache->PersistUsageProfileToDisk(*profile);
+      });
+}
+
 const std::shared_ptr<PipelineCacheVK>& PipelineLibraryVK::GetPSOCache() const {
   return pso_cache_;
 }
@@ -34,6 +34,12 @@ class PipelineLibraryVK final
 
   const std::shared_ptr<fml::ConcurrentTaskRunner>& GetWorkerTaskRunner() const;
 
+  // |PipelineLibrary|
+  std::shared_ptr<const fml::Mapping> GetUsageProfile() const override;
+
+  // |PipelineLibrary|
+  void SetUsageProfile(std::shared_ptr<const fml::Mapping> profile) override;
+
  private:
   friend ContextVK;
 
@@ -45,6 +51,10 @@ class PipelineLibraryVK final
   Mutex compute_pipelines_mutex_;
   ComputePipelineMap compute_pipelines_ IPLR_GUARDED_BY(
       compute_pipelines_mutex_);
+  mutable Mutex usage_profile_mutex_;
+  std::shared_ptr<const fml::Mapping> usage_profile_
+      IPLR_GUARDED_BY(usage_profile_mutex_);
+  bool usage_profile_dirty_ IPLR_GUARDED_BY(usage_profile_mutex_) = false;
   std::atomic_size_t frames_acquired_ = 0u;
   bool is_valid_ = false;
   bool cache_dirty_ = false;
@@ -76,6 +86,8 @@ class PipelineLibraryVK final
 
   void PersistPipelineCacheToDisk();
 
+  void PersistUsageProfileToDiskIfNeeded();
+
   PipelineLibraryVK(const PipelineLibraryVK&) = delete;
 
   PipelineLibraryVK& operator=(const PipelineLibraryVK&) = delete;
@@ -25,6 +25,9 @@ namespace impeller {
 // backend to avoid dynamic heap allocations.
 static constexpr size_t kMaxBindings = 32;
 
+// The minimum value of maxPushDescriptors guaranteed by VK_KHR_push_descriptor.
+static constexpr size_t kMinMaxPushDescriptors = 32;
+
 class PipelineVK final
     : public Pipeline<PipelineDescriptor>,
       public BackendCast<PipelineVK, Pipeline<PipelineDescriptor>> {
@@ -44,6 +47,11 @@ class PipelineVK final
 
   const vk::DescriptorSetLayout& GetDescriptorSetLayout() const;
 
+  /// Whether the descriptor set layout was created for push descriptors, in
+  /// which case bindings are pushed into the command buffer instead of being
+  /// written to an allocated descriptor set.
+  bool UsesPushDescriptors() const;
+
   std::shared_ptr<PipelineVK> CreateVariantForImmutableSamplers(
       const std::shared_ptr<SamplerVK>& immutable_sampler) const;
 
@@ -62,6 +70,7 @@ class PipelineVK final
   vk::UniquePipelineLayout layout_;
   vk::UniqueDescriptorSetLayout descriptor_set_layout_;
   std::shared_ptr<SamplerVK> immutable_sampler_;
+  bool uses_push_descriptors_ = false;
   mutable Mutex immutable_sampler_variants_mutex_;
   mutable ImmutableSamplerVariants immutable_sampler_variants_ IPLR_GUARDED_BY(
       immutable_sampler_variants_mutex_);
@@ -74,7 +83,8 @@ class PipelineVK final
              vk::UniqueRenderPass render_pass,
              vk::UniquePipelineLayout layout,
              vk::UniqueDescriptorSetLayout descriptor_set_layout,
-             std::shared_ptr<SamplerVK> immutable_sampler);
+             std::shared_ptr<SamplerVK> immutable_sampler,
+             bool uses_push_descriptors);
 
   // |Pipeline|
   bool IsValid() const override;
@@ -90,6 +90,7 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
                       vk::PipelineStageFlagBits::eTransfer;
 
   RenderPassBuilderVK builder;
+  ImageBarriersVK barriers;
 
   for (const auto& [bind_point, color] : render_target_.GetColorAttachments()) {
     builder.SetColorAttachment(
@@ -99,11 +100,13 @@ SharedHandleVK<vk::RenderPass> RenderPassVK::CreateVKRenderPass(
         color.load_action,                                   //
         color.store_action                                   //
     );
-    TextureVK::Cast(*color.texture).SetLayout(barrier);
+    TextureVK::Cast(*color.texture).SetLayout(barrier, barriers);
     if (color.resolve_texture) {
-      TextureVK::Cast(*color.resolve_texture).SetLayout(barrier);
+      TextureVK::Cast(*color.resolve_texture).SetLayout(barrier, barriers);
     }
   }
+  // Transition all color attachments with a single pipeline barrier.
+  barriers.Encode(barrier.cmd_buffer);
 
   if (auto depth = render_target_.GetDepthAttachment(); depth.has_value()) {
     builder.SetDepthStencilAttachment(
@@ -459,35 +462,52 @@ fml::Status RenderPassVK::Draw() {
 
   const auto& context_vk = ContextVK::Cast(*context_);
   const auto& pipeline_vk = PipelineVK::Cast(*pipeline_);
-
-  auto descriptor_result =
-      command_buffer_->GetEncoder()->AllocateDescriptorSets(
-          pipeline_vk.GetDescriptorSetLayout(), context_vk);
-  if (!descriptor_result.ok()) {
-    return fml::Status(fml::StatusCode::kAborted,
-                       "Could not allocate descriptor sets.");
-  }
-  const auto descriptor_set = descriptor_result.value();
   const auto pipeline_layout = pipeline_vk.GetPipelineLayout();
-  command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
-                                  pipeline_vk.GetPipeline());
 
-  for (auto i = 0u; i < descriptor_write_offset_; i++) {
-    write_workspace_[i].dstSet = descriptor_set;
-  }
+  if (pipeline_vk.UsesPushDescriptors()) {
+    // The bindings are recorded directly into the command buffer, so there is
+    // no descriptor set to allocate or update. Pushing requires at least one
+    // write.
+    command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                    pipeline_vk.GetPipeline());
+    if (descriptor_write_offset_ > 0u) {
+      command_buffer_vk_.pushDescriptorSetKHR(
+          vk::PipelineBindPoint::eGraphics,  // bind point
+          pipeline_layout,                   // layout
+          0,                                 // set
+          descriptor_write_offset_,          // write count
+          write_workspace_.data()            // writes
+      );
+    }
+  } else {
+    auto descriptor_result =
+        command_buffer_->GetEncoder()->AllocateDescriptorSets(
+            pipeline_vk.GetDescriptorSetLayout(), context_vk);
+    if (!descriptor_result.ok()) {
+      return fml::Status(fml::StatusCode::kAborted,
+                         "Could not allocate descriptor sets.");
+    }
+    const auto descriptor_set = descriptor_result.value();
+    command_buffer_vk_.bindPipeline(vk::PipelineBindPoint::eGraphics,
+                                    pipeline_vk.GetPipeline());
 
-  context_vk.GetDevice().updateDescriptorSets(descriptor_write_offset_,
-                                              write_workspace_.data(), 0u, {});
+    for (auto i = 0u; i < descriptor_write_offset_; i++) {
+      write_workspace_[i].dstSet = descriptor_set;
+    }
 
-  command_buffer_vk_.bindDescriptorSets(
-      vk::PipelineBindPoint::eGraphics,  // bind point
-      pipeline_layout,                   // layout
-      0,                                 // first set
-      1,                                 // set count
-      &descriptor_set,                   // sets
-      0,                                 // offset count
-      nullptr                            // offsets
-  );
+    context_vk.GetDevice().updateDescriptorSets(
+        descriptor_write_offset_, write_workspace_.data(), 0u, {});
+
+    command_buffer_vk_.bindDescriptorSets(
+        vk::PipelineBindPoint::eGraphics,  // bind point
+        pipeline_layout,                   // layout
+        0,                                 // first set
+        1,                                 // set count
+        &descriptor_set,                   // sets
+        0,                                 // offset count
+        nullptr                            // offsets
+    );
+  }
 
   if (pipeline_uses_input_attachments_) {
     InsertBarrierForInputAttachmentRead(
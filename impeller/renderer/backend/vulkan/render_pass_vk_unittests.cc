@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"  // IWYU pragma: keep
+#include "gtest/gtest.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/core/vertex_buffer.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/pipeline_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+#include "impeller/renderer/pipeline_library.h"
+#include "impeller/renderer/render_pass.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+std::shared_ptr<Pipeline<PipelineDescriptor>> MakePipeline(
+    const ContextVK& context) {
+  PipelineDescriptor pipeline_desc;
+  pipeline_desc.SetVertexDescriptor(std::make_shared<VertexDescriptor>());
+  return context.GetPipelineLibrary()->GetPipeline(pipeline_desc).Get();
+}
+
+bool WasCalled(const std::vector<std::string>& functions,
+               const std::string& function) {
+  return std::find(functions.begin(), functions.end(), function) !=
+         functions.end();
+}
+
+}  // namespace
+
+TEST(RenderPassVK, PushesDescriptorsWhenSupported) {
+  std::shared_ptr<ContextVK> context =
+      MockVulkanContextBuilder()
+          .SetDeviceExtensions({"VK_KHR_swapchain", "VK_KHR_push_descriptor"})
+          .Build();
+  std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline =
+      MakePipeline(*context);
+  ASSERT_TRUE(pipeline);
+  ASSERT_TRUE(PipelineVK::Cast(*pipeline).UsesPushDescriptors());
+
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  RenderTarget render_target = allocator.CreateOffscreen(*context, {1, 1}, 1);
+  std::shared_ptr<DeviceBuffer> buffer =
+      context->GetResourceAllocator()->CreateBuffer(DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kHostVisible,
+          .size = 1024,
+      });
+  ASSERT_TRUE(buffer);
+
+  std::shared_ptr<CommandBuffer> command_buffer =
+      context->CreateCommandBuffer();
+  std::shared_ptr<RenderPass> render_pass =
+      command_buffer->CreateRenderPass(render_target);
+  render_pass->SetPipeline(pipeline);
+  EXPECT_TRUE(render_pass->SetVertexBuffer(VertexBuffer{
+      .vertex_buffer = BufferView{buffer, Range(0, 512)},
+      .vertex_count = 3,
+      .index_type = IndexType::kNone,
+  }));
+  ShaderUniformSlot slot;
+  slot.binding = 0;
+  EXPECT_TRUE(render_pass->BindResource(
+      ShaderStage::kFragment, DescriptorType::kUniformBuffer, slot,
+      ShaderMetadata{}, BufferView{buffer, Range(512, 512)}));
+  EXPECT_TRUE(render_pass->Draw().ok());
+  EXPECT_TRUE(render_pass->EncodeCommands());
+
+  std::shared_ptr<std::vector<std::string>> functions =
+      GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_TRUE(WasCalled(*functions, "vkCmdPushDescriptorSetKHR"));
+  EXPECT_FALSE(WasCalled(*functions, "vkAllocateDescriptorSets"));
+}
+
+TEST(RenderPassVK, DoesNotPushEmptyDescriptorWrites) {
+  std::shared_ptr<ContextVK> context =
+      MockVulkanContextBuilder()
+          .SetDeviceExtensions({"VK_KHR_swapchain", "VK_KHR_push_descriptor"})
+          .Build();
+  std::shared_ptr<Pipeline<PipelineDescriptor>> pipeline =
+      MakePipeline(*context);
+  ASSERT_TRUE(pipeline);
+  ASSERT_TRUE(PipelineVK::Cast(*pipeline).UsesPushDescriptors());
+
+  RenderTargetAllocator allocator(context->GetResourceAllocator());
+  RenderTarget render_target = allocator.CreateOffscreen(*context, {1, 1}, 1);
+  std::shared_ptr<DeviceBuffer> buffer =
+      context->GetResourceAllocator()->CreateBuffer(DeviceBufferDescriptor{
+          .storage_mode = StorageMode::kHostVisible,
+          .size = 512,
+      });
+  ASSERT_TRUE(buffer);
+
+  std::shared_ptr<CommandBuffer> command_buffer =
+      context->CreateCommandBuffer();
+  std::shared_ptr<RenderPass> render_pass =
+      command_buffer->CreateRenderPass(render_target);
+  render_pass->SetPipeline(pipeline);
+  EXPECT_TRUE(render_pass->SetVertexBuffer(VertexBuffer{
+      .vertex_buffer = BufferView{buffer, Range(0, 512)},
+      .vertex_count = 3,
+      .index_type = IndexType::kNone,
+  }));
+  EXPECT_TRUE(render_pass->Draw().ok());
+  EXPECT_TRUE(render_pass->EncodeCommands());
+
+  std::shared_ptr<std::vector<std::string>> functions =
+      GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_FALSE(WasCalled(*functions, "vkCmdPushDescriptorSetKHR"));
+  EXPECT_FALSE(WasCalled(*functions, "vkAllocateDescriptorSets"));
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -198,16 +198,23 @@ void vkGetPhysicalDeviceQueueFamilyProperties(
   }
 }
 
+static thread_local std::vector<std::string> g_device_extensions;
+
 VkResult vkEnumerateDeviceExtensionProperties(
     VkPhysicalDevice physicalDevice,
     const char* pLayerName,
     uint32_t* pPropertyCount,
     VkExtensionProperties* pProperties) {
   if (!pProperties) {
-    *pPropertyCount = 1;
+    *pPropertyCount = g_device_extensions.size();
   } else {
-    strcpy(pProperties[0].extensionName, "VK_KHR_swapchain");
-    pProperties[0].specVersion = 0;
+    uint32_t count = 0;
+    for (const std::string& ext : g_device_extensions) {
+      strncpy(pProperties[count].extensionName, ext.c_str(),
+              sizeof(VkExtensionProperties::extensionName));
+      pProperties[count].specVersion = 0;
+      count++;
+    }
   }
   return VK_SUCCESS;
 }
@@ -442,6 +449,22 @@ void vkCmdBindPipeline(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdBindPipeline");
 }
 
+void vkCmdPipelineBarrier(
+    VkCommandBuffer commandBuffer,
+    VkPipelineStageFlags srcStageMask,
+    VkPipelineStageFlags dstStageMask,
+    VkDependencyFlags dependencyFlags,
+    uint32_t memoryBarrierCount,
+    const VkMemoryBarrier* pMemoryBarriers,
+    uint32_t bufferMemoryBarrierCount,
+    const VkBufferMemoryBarrier* pBufferMemoryBarriers,
+    uint32_t imageMemoryBarrierCount,
+    const VkImageMemoryBarrier* pImageMemoryBarriers) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back("vkCmdPipelineBarrier");
+}
+
 void vkCmdSetStencilReference(VkCommandBuffer commandBuffer,
                               VkStencilFaceFlags faceMask,
                               uint32_t reference) {
@@ -468,6 +491,18 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
 }
 
+void vkCmdPushDescriptorSetKHR(VkCommandBuffer commandBuffer,
+                               VkPipelineBindPoint pipelineBindPoint,
+                               VkPipelineLayout layout,
+                               uint32_t set,
+                               uint32_t descriptorWriteCount,
+                               const VkWriteDescriptorSet* pDescriptorWrites) {
+  MockCommandBuffer* mock_command_buffer =
+      reinterpret_cast<MockCommandBuffer*>(commandBuffer);
+  mock_command_buffer->called_functions_->push_back(
+      "vkCmdPushDescriptorSetKHR");
+}
+
 void vkFreeCommandBuffers(VkDevice device,
                           VkCommandPool commandPool,
                           uint32_t commandBufferCount,
@@ -494,6 +529,7 @@ VkResult vkCreateFence(VkDevice device,
                        const VkAllocationCallbacks* pAllocator,
                        VkFence* pFence) {
   MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->AddCalledFunction("vkCreateFence");
   *pFence = reinterpret_cast<VkFence>(new MockFence());
   return VK_SUCCESS;
 }
@@ -824,12 +860,16 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkDestroyPipelineCache;
   } else if (strcmp("vkCmdBindPipeline", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdBindPipeline;
+  } else if (strcmp("vkCmdPipelineBarrier", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdPipelineBarrier;
   } else if (strcmp("vkCmdSetStencilReference", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetStencilReference;
   } else if (strcmp("vkCmdSetScissor", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetScissor;
   } else if (strcmp("vkCmdSetViewport", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetViewport;
+  } else if (strcmp("vkCmdPushDescriptorSetKHR", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCmdPushDescriptorSetKHR;
   } else if (strcmp("vkDestroyCommandPool", pName) == 0) {
     return (PFN_vkVoidFunction)vkDestroyCommandPool;
   } else if (strcmp("vkFreeCommandBuffers", pName) == 0) {
@@ -898,6 +938,7 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
 
 MockVulkanContextBuilder::MockVulkanContextBuilder()
     : instance_extensions_({"VK_KHR_surface", "VK_MVK_macos_surface"}),
+      device_extensions_({"VK_KHR_swapchain"}),
       format_properties_callback_([](VkPhysicalDevice physicalDevice,
                                      VkFormat format,
                                      VkFormatProperties* pFormatProperties) {
@@ -925,6 +966,7 @@ std::shared_ptr<ContextVK> MockVulkanContextBuilder::Build() {
   }
   g_instance_extensions = instance_extensions_;
   g_instance_layers = instance_layers_;
+  g_device_extensions = device_extensions_;
   g_format_properties_callback = format_properties_callback_;
   g_physical_device_properties_callback = physical_properties_callback_;
   std::shared_ptr<ContextVK> result = ContextVK::Create(std::move(settings));
@@ -32,9 +32,17 @@ vk::ImageLayout TextureSourceVK::SetLayoutWithoutEncoding(
 }
 
 fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
+  ImageBarriersVK barriers;
+  SetLayout(barrier, barriers);
+  barriers.Encode(barrier.cmd_buffer);
+  return {};
+}
+
+void TextureSourceVK::SetLayout(const BarrierVK& barrier,
+                                ImageBarriersVK& barriers) const {
   const auto old_layout = SetLayoutWithoutEncoding(barrier.new_layout);
   if (barrier.new_layout == old_layout) {
-    return {};
+    return;
   }
 
   vk::ImageMemoryBarrier image_barrier;
@@ -51,15 +59,7 @@ fml::Status TextureSourceVK::SetLayout(const BarrierVK& barrier) const {
   image_barrier.subresourceRange.baseArrayLayer = 0u;
   image_barrier.subresourceRange.layerCount = ToArrayLayerCount(desc_.type);
 
-  barrier.cmd_buffer.pipelineBarrier(barrier.src_stage,  // src stage
-                                     barrier.dst_stage,  // dst stage
-                                     {},                 // dependency flags
-                                     nullptr,            // memory barriers
-                                     nullptr,            // buffer barriers
-                                     image_barrier       // image barriers
-  );
-
-  return {};
+  barriers.Add(image_barrier, barrier.src_stage, barrier.dst_stage);
 }
 
 void TextureSourceVK::SetCachedFramebuffer(
@@ -85,6 +85,18 @@ class TextureSourceVK {
   ///
   fml::Status SetLayout(const BarrierVK& barrier) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Like `SetLayout`, but adds the transition to `barriers`
+  ///             instead of encoding it. `barrier.cmd_buffer` is ignored.
+  ///
+  ///             This allows the transitions of several images to be encoded
+  ///             together once all of them have been added.
+  ///
+  /// @param[in]  barrier   The barrier.
+  /// @param      barriers  The collection to add the transition to.
+  ///
+  void SetLayout(const BarrierVK& barrier, ImageBarriersVK& barriers) const;
+
   //----------------------------------------------------------------------------
   /// @brief      Store the layout of the image.
   ///
@@ -160,6 +160,15 @@ bool TextureVK::SetLayout(const BarrierVK& barrier) const {
   return source_ ? source_->SetLayout(barrier).ok() : false;
 }
 
+bool TextureVK::SetLayout(const BarrierVK& barrier,
+                          ImageBarriersVK& barriers) const {
+  if (!source_) {
+    return false;
+  }
+  source_->SetLayout(barrier, barriers);
+  return true;
+}
+
 vk::ImageLayout TextureVK::SetLayoutWithoutEncoding(
     vk::ImageLayout layout) const {
   return source_ ? source_->SetLayoutWithoutEncoding(layout)
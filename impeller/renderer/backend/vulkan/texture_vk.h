@@ -32,6 +32,8 @@ class TextureVK final : public Texture, public BackendCast<TextureVK, Texture> {
 
   bool SetLayout(const BarrierVK& barrier) const;
 
+  bool SetLayout(const BarrierVK& barrier, ImageBarriersVK& barriers) const;
+
   vk::ImageLayout SetLayoutWithoutEncoding(vk::ImageLayout layout) const;
 
   vk::ImageLayout GetLayout() const;
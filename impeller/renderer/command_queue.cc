@@ -30,4 +30,12 @@ fml::Status CommandQueue::Submit(
   return fml::Status();
 }
 
+fml::Status CommandQueue::Enqueue(std::shared_ptr<CommandBuffer> buffer) {
+  return Submit({std::move(buffer)});
+}
+
+fml::Status CommandQueue::Flush() {
+  return fml::Status();
+}
+
 }  // namespace impeller
@@ -39,6 +39,18 @@ class CommandQueue {
       const std::vector<std::shared_ptr<CommandBuffer>>& buffers,
       const CompletionCallback& completion_callback = {});
 
+  /// @brief Enqueue a command buffer for submission with the next call to
+  ///        |Submit| or |Flush| made on the same thread.
+  ///
+  ///        Enqueued command buffers are always submitted before any buffers
+  ///        subsequently passed to |Submit| on that thread, so ordering
+  ///        between dependent offscreen passes is preserved. Backends that
+  ///        cannot batch submissions submit the buffer immediately.
+  virtual fml::Status Enqueue(std::shared_ptr<CommandBuffer> buffer);
+
+  /// @brief Submit all command buffers enqueued on the calling thread.
+  virtual fml::Status Flush();
+
  private:
   CommandQueue(const CommandQueue&) = delete;
 
@@ -10,6 +10,13 @@ PipelineLibrary::PipelineLibrary() = default;
 
 PipelineLibrary::~PipelineLibrary() = default;
 
+std::shared_ptr<const fml::Mapping> PipelineLibrary::GetUsageProfile() const {
+  return nullptr;
+}
+
+void PipelineLibrary::SetUsageProfile(
+    std::shared_ptr<const fml::Mapping> profile) {}
+
 PipelineFuture<PipelineDescriptor> PipelineLibrary::GetPipeline(
     std::optional<PipelineDescriptor> descriptor,
     bool async) {
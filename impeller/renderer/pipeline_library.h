@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "compute_pipeline_descriptor.h"
+#include "flutter/fml/mapping.h"
 #include "impeller/renderer/pipeline.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 
@@ -51,6 +52,24 @@ class PipelineLibrary : public std::enable_shared_from_this<PipelineLibrary> {
   virtual void RemovePipelinesWithEntryPoint(
       std::shared_ptr<const ShaderFunction> function) = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Opaque client data describing the pipeline variants that
+  ///             were created in a previous run. This can be used to create
+  ///             those variants ahead of their first use.
+  ///
+  /// @return     The usage profile, or nullptr if the backend does not
+  ///             persist one or none was recorded yet.
+  ///
+  virtual std::shared_ptr<const fml::Mapping> GetUsageProfile() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Update the usage profile. Backends that persist a pipeline
+  ///             cache store the profile next to it.
+  ///
+  /// @param[in]  profile  The opaque client data.
+  ///
+  virtual void SetUsageProfile(std::shared_ptr<const fml::Mapping> profile);
+
  protected:
   PipelineLibrary();
 
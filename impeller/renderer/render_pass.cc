@@ -4,6 +4,7 @@
 
 #include "impeller/renderer/render_pass.h"
 #include "fml/status.h"
+#include "impeller/renderer/vertex_descriptor.h"
 
 namespace impeller {
 
@@ -92,6 +93,51 @@ const std::shared_ptr<const Context>& RenderPass::GetContext() const {
 void RenderPass::SetPipeline(
     const std::shared_ptr<Pipeline<PipelineDescriptor>>& pipeline) {
   pending_.pipeline = pipeline;
+  if (!pipeline) {
+    return;
+  }
+
+  // Size the binding lists from the pipeline layout so that binding resources
+  // for this command costs at most one allocation per list instead of one per
+  // growth step.
+  const auto& vertex_descriptor =
+      pipeline->GetDescriptor().GetVertexDescriptor();
+  if (!vertex_descriptor) {
+    return;
+  }
+  size_t vertex_buffers = 0u;
+  size_t vertex_images = 0u;
+  size_t fragment_buffers = 0u;
+  size_t fragment_images = 0u;
+  for (const DescriptorSetLayout& layout :
+       vertex_descriptor->GetDescriptorSetLayouts()) {
+    const bool is_vertex = layout.shader_stage == ShaderStage::kVertex;
+    switch (layout.descriptor_type) {
+      case DescriptorType::kUniformBuffer:
+      case DescriptorType::kStorageBuffer:
+        if (is_vertex) {
+          vertex_buffers++;
+        } else {
+          fragment_buffers++;
+        }
+        break;
+      case DescriptorType::kSampledImage:
+        if (is_vertex) {
+          vertex_images++;
+        } else {
+          fragment_images++;
+        }
+        break;
+      case DescriptorType::kImage:
+      case DescriptorType::kSampler:
+      case DescriptorType::kInputAttachment:
+        break;
+    }
+  }
+  pending_.vertex_bindings.buffers.reserve(vertex_buffers);
+  pending_.vertex_bindings.sampled_images.reserve(vertex_images);
+  pending_.fragment_bindings.buffers.reserve(fragment_buffers);
+  pending_.fragment_bindings.sampled_images.reserve(fragment_images);
 }
 
 void RenderPass::SetCommandLabel(std::string_view label) {
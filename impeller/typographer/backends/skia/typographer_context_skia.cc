@@ -247,22 +247,30 @@ static void DrawGlyph(SkCanvas* canvas,
   canvas->restore();
 }
 
-/// @brief Batch render to a single surface.
+/// @brief Batch render to a single surface covering |region| of |texture|.
 ///
-/// This is only safe for use when updating a fresh texture.
+/// This is only safe for use when updating a region of a fresh texture that
+/// contains no previously rendered glyphs. Only the pixels of |region| are
+/// rasterized and uploaded, so growing an atlas does not pay for the area
+/// that is subsequently filled in by blitting the old atlas.
 static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
                                   std::shared_ptr<BlitPass>& blit_pass,
                                   HostBuffer& host_buffer,
                                   const std::shared_ptr<Texture>& texture,
                                   const std::vector<FontGlyphPair>& new_pairs,
                                   size_t start_index,
-                                  size_t end_index) {
+                                  size_t end_index,
+                                  IRect region) {
   TRACE_EVENT0("impeller", __FUNCTION__);
 
   bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
 
+  if (region.IsEmpty()) {
+    return true;
+  }
+
   SkBitmap bitmap;
-  bitmap.setInfo(GetImageInfo(atlas, Size(texture->GetSize())));
+  bitmap.setInfo(GetImageInfo(atlas, Size(region.GetSize())));
   if (!bitmap.tryAllocPixels()) {
     return false;
   }
@@ -288,7 +296,9 @@ static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
       continue;
     }
 
-    DrawGlyph(canvas, SkPoint::Make(pos.GetLeft(), pos.GetTop()),
+    DrawGlyph(canvas,
+              SkPoint::Make(pos.GetLeft() - region.GetX(),
+                            pos.GetTop() - region.GetY()),
               pair.scaled_font, pair.glyph, bounds, pair.glyph.properties,
               has_color);
   }
@@ -297,15 +307,13 @@ static bool BulkUpdateAtlasBitmap(const GlyphAtlas& atlas,
   // benchmarks as substantially faster on a number of Android devices.
   BufferView buffer_view = host_buffer.Emplace(
       bitmap.getAddr(0, 0),
-      texture->GetSize().Area() *
-          BytesPerPixelForPixelFormat(
-              atlas.GetTexture()->GetTextureDescriptor().format),
+      region.Area() * BytesPerPixelForPixelFormat(
+                          atlas.GetTexture()->GetTextureDescriptor().format),
       DefaultUniformAlignment());
 
   return blit_pass->AddCopy(std::move(buffer_view),  //
                             texture,                 //
-                            IRect::MakeXYWH(0, 0, texture->GetSize().width,
-                                            texture->GetSize().height));
+                            region);
 }
 
 static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
@@ -609,17 +617,22 @@ std::shared_ptr<GlyphAtlas> TypographerContextSkia::CreateGlyphAtlas(
   // Step 4a: Draw new font-glyph pairs into the a host buffer and encode
   // the uploads into the blit pass.
   // ---------------------------------------------------------------------------
+  // Glyphs that did not fit in the old atlas are packed below the
+  // |height_adjustment| rows occupied by it, so only that region needs to be
+  // rasterized and uploaded. The rest is filled in by the blit below.
+  IRect upload_region = IRect::MakeLTRB(0, height_adjustment, atlas_size.width,
+                                        atlas_size.height);
   if (!BulkUpdateAtlasBitmap(*new_atlas, blit_pass, host_buffer,
                              new_atlas->GetTexture(), new_glyphs,
-                             first_missing_index, new_glyphs.size())) {
+                             first_missing_index, new_glyphs.size(),
+                             upload_region)) {
     return nullptr;
   }
 
   // Blit the old texture to the top left of the new atlas.
   if (blit_old_atlas && old_texture) {
     blit_pass->AddCopy(old_texture, new_atlas->GetTexture(),
-                       IRect::MakeSize(new_atlas->GetTexture()->GetSize()),
-                       {0, 0});
+                       IRect::MakeSize(old_texture->GetSize()), {0, 0});
   }
 
   // ---------------------------------------------------------------------------
@@ -3,6 +3,10 @@
 // found in the LICENSE file.
 
 #include "impeller/typographer/text_frame.h"
+
+#include <algorithm>
+#include <cmath>
+
 #include "impeller/typographer/font.h"
 #include "impeller/typographer/font_glyph_pair.h"
 
@@ -42,7 +46,20 @@ Scalar TextFrame::RoundScaledFontSize(Scalar scale, Scalar point_size) {
   // CTM, a glyph will fit in the atlas. If we clamp significantly, this may
   // reduce fidelity but is preferable to the alternative of failing to render.
   constexpr Scalar kMaximumTextScale = 48;
+  // Above this rendered size (in pixels), the font size is quantized relative
+  // to its magnitude instead of in fixed 0.01 scale steps. Each octave of
+  // sizes is split into |kSizeStepsPerOctave| steps, bounding the stretch
+  // applied when drawing the glyph to under 1% while avoiding a new set of
+  // rasterized glyphs on nearly every frame of a scale animation.
+  constexpr Scalar kCoarseQuantizationSize = 64;
+  constexpr Scalar kSizeStepsPerOctave = 64;
   Scalar result = std::round(scale * 100) / 100;
+  Scalar pixel_size = scale * point_size;
+  if (point_size > 0 && pixel_size > kCoarseQuantizationSize) {
+    Scalar step =
+        std::exp2(std::floor(std::log2(pixel_size))) / kSizeStepsPerOctave;
+    result = std::round(pixel_size / step) * step / point_size;
+  }
   return std::clamp(result, 0.0f, kMaximumTextScale);
 }
 
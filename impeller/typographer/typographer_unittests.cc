@@ -8,6 +8,7 @@
 #include "impeller/core/host_buffer.h"
 #include "impeller/playground/playground.h"
 #include "impeller/playground/playground_test.h"
+#include "impeller/renderer/testing/mocks.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/typographer_context_skia.h"
 #include "impeller/typographer/font_glyph_pair.h"
@@ -26,6 +27,9 @@
 namespace impeller {
 namespace testing {
 
+using ::testing::NiceMock;
+using ::testing::Return;
+
 using TypographerTest = PlaygroundTest;
 INSTANTIATE_PLAYGROUND_SUITE(TypographerTest);
 
@@ -485,6 +489,152 @@ TEST_P(TypographerTest, GlyphAtlasTextureWillGrowTilMaxTextureSize) {
   ASSERT_EQ(atlas->GetGlyphCount(), 2u);
 }
 
+namespace {
+
+// Forwards to a real context, but records the buffer to texture copies that
+// are encoded into blit passes instead of submitting them.
+class UploadRecordingContext final : public Context {
+ public:
+  struct Upload {
+    std::shared_ptr<Texture> texture;
+    IRect region;
+  };
+
+  explicit UploadRecordingContext(std::shared_ptr<Context> context)
+      : context_(std::move(context)),
+        command_queue_(std::make_shared<NiceMock<MockCommandQueue>>()) {
+    ON_CALL(*command_queue_, Submit).WillByDefault(Return(fml::Status()));
+  }
+
+  const std::vector<Upload>& GetUploads() const { return uploads_; }
+
+  void ClearUploads() { uploads_.clear(); }
+
+  // |Context|
+  BackendType GetBackendType() const override {
+    return context_->GetBackendType();
+  }
+
+  // |Context|
+  std::string DescribeGpuModel() const override {
+    return context_->DescribeGpuModel();
+  }
+
+  // |Context|
+  bool IsValid() const override { return context_->IsValid(); }
+
+  // |Context|
+  const std::shared_ptr<const Capabilities>& GetCapabilities() const override {
+    return context_->GetCapabilities();
+  }
+
+  // |Context|
+  std::shared_ptr<Allocator> GetResourceAllocator() const override {
+    return context_->GetResourceAllocator();
+  }
+
+  // |Context|
+  std::shared_ptr<ShaderLibrary> GetShaderLibrary() const override {
+    return context_->GetShaderLibrary();
+  }
+
+  // |Context|
+  std::shared_ptr<SamplerLibrary> GetSamplerLibrary() const override {
+    return context_->GetSamplerLibrary();
+  }
+
+  // |Context|
+  std::shared_ptr<PipelineLibrary> GetPipelineLibrary() const override {
+    return context_->GetPipelineLibrary();
+  }
+
+  // |Context|
+  std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override {
+    auto blit_pass = std::make_shared<NiceMock<MockBlitPass>>();
+    ON_CALL(*blit_pass, IsValid).WillByDefault(Return(true));
+    ON_CALL(*blit_pass, EncodeCommands).WillByDefault(Return(true));
+    ON_CALL(*blit_pass, OnCopyTextureToTextureCommand)
+        .WillByDefault(Return(true));
+    ON_CALL(*blit_pass, OnCopyBufferToTextureCommand)
+        .WillByDefault([this](BufferView source,
+                              std::shared_ptr<Texture> destination,
+                              IRect destination_region, std::string label,
+                              uint32_t slice, bool convert_to_read) {
+          uploads_.push_back({std::move(destination), destination_region});
+          return true;
+        });
+    auto command_buffer =
+        std::make_shared<NiceMock<MockCommandBuffer>>(context_);
+    ON_CALL(*command_buffer, IsValid).WillByDefault(Return(true));
+    ON_CALL(*command_buffer, OnCreateBlitPass)
+        .WillByDefault(Return(std::shared_ptr<BlitPass>(blit_pass)));
+    return command_buffer;
+  }
+
+  // |Context|
+  std::shared_ptr<CommandQueue> GetCommandQueue() const override {
+    return command_queue_;
+  }
+
+  // |Context|
+  void Shutdown() override {}
+
+ private:
+  const std::shared_ptr<Context> context_;
+  const std::shared_ptr<NiceMock<MockCommandQueue>> command_queue_;
+  mutable std::vector<Upload> uploads_;
+};
+
+}  // namespace
+
+TEST_P(TypographerTest, GlyphAtlasGrowthOnlyUploadsNewRows) {
+  if (GetBackend() == PlaygroundBackend::kOpenGLES) {
+    GTEST_SKIP() << "Atlas growth isn't supported for OpenGLES currently.";
+  }
+
+  UploadRecordingContext context(GetContext());
+  auto host_buffer = HostBuffer::Create(GetContext()->GetResourceAllocator());
+  auto typographer_context = TypographerContextSkia::Make();
+  auto atlas_context = typographer_context->CreateGlyphAtlasContext(
+      GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_TRUE(typographer_context && typographer_context->IsValid());
+
+  std::shared_ptr<GlyphAtlas> atlas;
+  size_t growth_count = 0;
+  for (int i = 0; i < 4; i++) {
+    SkFont sk_font = flutter::testing::CreateTestFontOfSize(50 + i);
+    auto blob = SkTextBlob::MakeFromString("A", sk_font);
+    ASSERT_TRUE(blob);
+
+    const int64_t old_height = atlas_context->GetAtlasSize().height;
+    std::shared_ptr<Texture> old_texture =
+        atlas ? atlas->GetTexture() : nullptr;
+    context.ClearUploads();
+
+    auto next_atlas =
+        CreateGlyphAtlas(context, typographer_context.get(), *host_buffer,
+                         GlyphAtlas::Type::kAlphaBitmap, 50 + i, atlas_context,
+                         *MakeTextFrameFromTextBlobSkia(blob));
+    ASSERT_TRUE(!!next_atlas);
+
+    if (next_atlas == atlas && next_atlas->GetTexture() != old_texture) {
+      // The atlas grew. The rows of the old atlas are blitted from the old
+      // texture, so the only upload into the new texture starts right below
+      // them.
+      growth_count++;
+      const ISize new_size = next_atlas->GetTexture()->GetSize();
+      ASSERT_EQ(context.GetUploads().size(), 1u);
+      const UploadRecordingContext::Upload& upload = context.GetUploads()[0];
+      EXPECT_EQ(upload.texture, next_atlas->GetTexture());
+      EXPECT_EQ(upload.region, IRect::MakeLTRB(0, old_height, new_size.width,
+                                               new_size.height));
+    }
+    atlas = next_atlas;
+  }
+  EXPECT_GT(growth_count, 0u);
+  ASSERT_EQ(atlas->GetGlyphCount(), 4u);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
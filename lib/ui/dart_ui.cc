@@ -26,6 +26,7 @@
 #include "flutter/lib/ui/painting/image_filter.h"
 #include "flutter/lib/ui/painting/image_shader.h"
 #include "flutter/lib/ui/painting/immutable_buffer.h"
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
 #include "flutter/lib/ui/painting/path.h"
 #include "flutter/lib/ui/painting/path_measure.h"
 #include "flutter/lib/ui/painting/picture.h"
@@ -74,6 +75,7 @@ typedef CanvasPath Path;
   V(Gradient::Create)                                              \
   V(ImageFilter::Create)                                           \
   V(ImageShader::Create)                                           \
+  V(IncrementalImageDecoder::Create)                               \
   V(ParagraphBuilder::Create)                                      \
   V(PathMeasure::Create)                                           \
   V(Path::Create)                                                  \
@@ -207,6 +209,9 @@ typedef CanvasPath Path;
   V(ImageShader, initWithImage)                 \
   V(ImmutableBuffer, dispose)                   \
   V(ImmutableBuffer, length)                    \
+  V(IncrementalImageDecoder, addChunk)          \
+  V(IncrementalImageDecoder, close)             \
+  V(IncrementalImageDecoder, dispose)           \
   V(ParagraphBuilder, addPlaceholder)           \
   V(ParagraphBuilder, addText)                  \
   V(ParagraphBuilder, build)                    \
@@ -1804,6 +1804,21 @@ enum ImageByteFormat {
   ///  * <https://en.wikipedia.org/wiki/Portable_Network_Graphics>, the Wikipedia page on PNG.
   ///  * <https://tools.ietf.org/rfc/rfc2083.txt>, the PNG standard.
   png,
+
+  /// QOI format.
+  ///
+  /// The "Quite OK Image" format, a loss-less compression format that encodes
+  /// much faster than [png] at the cost of larger output. Pixels are stored as
+  /// RGBA with straight alpha. This format is well suited for screenshots and
+  /// thumbnails that are produced in bulk, where encoding speed matters more
+  /// than size.
+  ///
+  /// This format is not supported on the web.
+  ///
+  /// See also:
+  ///
+  ///  * <https://qoiformat.org/qoi-specification.pdf>, the QOI specification.
+  qoi,
 }
 
 /// The format of pixel data given to [decodeImageFromPixels].
@@ -2310,6 +2325,161 @@ base class _NativeCodec extends NativeFieldWrapperClass1 implements Codec {
   String toString() => 'Codec(${_cachedFrameCount == null ? "" : "$_cachedFrameCount frames"})';
 }
 
+/// The order in which pending image decodes are started.
+///
+/// Decodes of the same priority are started in the order they were requested.
+/// A decode that has not started yet when its [Codec] is disposed is skipped.
+/// The futures returned by [Codec.getNextFrame] for a codec that is disposed
+/// before its frame is decoded complete with an error saying that the decode
+/// was cancelled.
+///
+/// Priorities only affect static images. The frames of animated images are
+/// decoded as they are requested.
+// This must be kept in sync with the `ImageDecodePriority` enum in
+// image_decode_queue.h.
+enum ImageDecodePriority {
+  /// For images that are not visible yet, such as images prefetched ahead of
+  /// a scroll.
+  low,
+
+  /// The default priority.
+  normal,
+
+  /// For images that are visible, or are about to become visible, and that the
+  /// next frames are waiting for.
+  high,
+}
+
+/// Signature for [IncrementalImageDecoder.onImage].
+///
+/// The `image` is owned by the callback, which must dispose it once it is no
+/// longer needed. The `isComplete` argument is true for the last image.
+typedef IncrementalImageCallback = void Function(Image image, bool isComplete);
+
+/// Decodes a still image while its encoded bytes are still arriving, such as
+/// an image that is being downloaded over a slow connection.
+///
+/// Pass the bytes to [addChunk] as they arrive, and call [close] once all of
+/// them have been added. The partially decoded image is passed to [onImage]
+/// at most once per [minFrameInterval]. Interlaced PNG and GIF images are
+/// decoded incrementally, so each image only costs the decoding of the bytes
+/// that arrived since the previous one. Other formats, including progressive
+/// JPEG images, decode all of the bytes that arrived so far for each image.
+///
+/// Only the first frame of animated images is decoded, at the intrinsic size
+/// of the image. Use [instantiateImageCodec] to decode animated images or to
+/// resize images.
+///
+/// Once the last image has been passed to [onImage], the decoder releases the
+/// encoded bytes, so it holds no more memory than the decoded image.
+///
+/// The decoder must be disposed with [dispose] if the image is no longer
+/// needed before it has been decoded.
+base class IncrementalImageDecoder extends NativeFieldWrapperClass1 {
+  /// Creates a decoder that passes the decoded images to `onImage`.
+  IncrementalImageDecoder({
+    required this.onImage,
+    this.minFrameInterval = const Duration(milliseconds: 100),
+  }) {
+    _constructor(minFrameInterval.inMilliseconds, _handleImage);
+  }
+
+  @Native<Void Function(Handle, Int32, Handle)>(symbol: 'IncrementalImageDecoder::Create')
+  external void _constructor(int minFrameIntervalMilliseconds, void Function(_Image?, bool, String) callback);
+
+  /// Called with each image decoded from the bytes added so far.
+  final IncrementalImageCallback onImage;
+
+  /// The minimum time between two images passed to [onImage], apart from the
+  /// last image, which is passed as soon as it is decoded.
+  final Duration minFrameInterval;
+
+  bool _closed = false;
+  bool _disposed = false;
+  bool _complete = false;
+  String? _decodeError;
+  Completer<void>? _completer;
+
+  void _handleImage(_Image? image, bool isComplete, String decodeError) {
+    if (image != null) {
+      onImage(Image._(image, image.width, image.height), isComplete);
+    }
+    if (!isComplete) {
+      return;
+    }
+    _complete = true;
+    if (image == null) {
+      _decodeError = decodeError.isEmpty
+          ? 'Failed to decode the image, possibly due to invalid image data.'
+          : decodeError;
+    }
+    final Completer<void>? completer = _completer;
+    if (completer != null) {
+      _completeWithResult(completer);
+    }
+  }
+
+  void _completeWithResult(Completer<void> completer) {
+    if (_decodeError == null) {
+      completer.complete();
+    } else {
+      completer.completeError(Exception(_decodeError));
+    }
+  }
+
+  /// Appends the next bytes of the encoded image.
+  ///
+  /// Bytes added after the image has been fully decoded are ignored.
+  void addChunk(Uint8List chunk) {
+    assert(!_closed, 'Cannot add bytes to a closed IncrementalImageDecoder.');
+    if (_closed) {
+      return;
+    }
+    _addChunk(chunk);
+  }
+
+  @Native<Void Function(Pointer<Void>, Handle)>(symbol: 'IncrementalImageDecoder::addChunk')
+  external void _addChunk(Uint8List chunk);
+
+  /// Signals that all bytes of the encoded image have been added.
+  ///
+  /// The returned future completes once the last image has been passed to
+  /// [onImage], or with an error if the image could not be decoded. It never
+  /// completes if the decoder is disposed first.
+  Future<void> close() {
+    if (!_closed) {
+      _closed = true;
+      _close();
+    }
+    final Completer<void> completer = _completer ??= Completer<void>();
+    if (_complete && !completer.isCompleted) {
+      _completeWithResult(completer);
+    }
+    return completer.future;
+  }
+
+  @Native<Void Function(Pointer<Void>)>(symbol: 'IncrementalImageDecoder::close')
+  external void _close();
+
+  /// Stops decoding and releases the resources held by the decoder.
+  ///
+  /// The images already passed to [onImage] are not disposed.
+  void dispose() {
+    if (_disposed) {
+      return;
+    }
+    _disposed = true;
+    _closed = true;
+    _dispose();
+  }
+
+  @Native<Void Function(Pointer<Void>)>(symbol: 'IncrementalImageDecoder::dispose')
+  external void _dispose();
+
+  @override
+  String toString() => 'IncrementalImageDecoder(${_complete ? "complete" : "decoding"})';
+}
+
 /// Instantiates an image [Codec].
 ///
 /// This method is a convenience wrapper around the [ImageDescriptor] API, and
@@ -2343,6 +2513,9 @@ base class _NativeCodec extends NativeFieldWrapperClass1 implements Codec {
 /// Instead, prefer scaling the [Canvas] transform. If the image must be scaled
 /// up, the `allowUpscaling` parameter must be set to true.
 ///
+/// The `priority` argument orders the decode relative to other pending
+/// decodes. See [ImageDecodePriority].
+///
 /// The returned future can complete with an error if the image decoding has
 /// failed.
 Future<Codec> instantiateImageCodec(
@@ -2350,6 +2523,7 @@ Future<Codec> instantiateImageCodec(
   int? targetWidth,
   int? targetHeight,
   bool allowUpscaling = true,
+  ImageDecodePriority priority = ImageDecodePriority.normal,
 }) async {
   final ImmutableBuffer buffer = await ImmutableBuffer.fromUint8List(list);
   return instantiateImageCodecFromBuffer(
@@ -2357,6 +2531,7 @@ Future<Codec> instantiateImageCodec(
     targetWidth: targetWidth,
     targetHeight: targetHeight,
     allowUpscaling: allowUpscaling,
+    priority: priority,
   );
 }
 
@@ -2390,6 +2565,9 @@ Future<Codec> instantiateImageCodec(
 /// Instead, prefer scaling the [Canvas] transform. If the image must be scaled
 /// up, the `allowUpscaling` parameter must be set to true.
 ///
+/// The [priority] argument orders the decode relative to other pending
+/// decodes. See [ImageDecodePriority].
+///
 /// The returned future can complete with an error if the image decoding has
 /// failed.
 ///
@@ -2404,9 +2582,11 @@ Future<Codec> instantiateImageCodecFromBuffer(
   int? targetWidth,
   int? targetHeight,
   bool allowUpscaling = true,
+  ImageDecodePriority priority = ImageDecodePriority.normal,
 }) {
   return instantiateImageCodecWithSize(
     buffer,
+    priority: priority,
     getTargetSize: (int intrinsicWidth, int intrinsicHeight) {
       if (!allowUpscaling) {
         if (targetWidth != null && targetWidth! > intrinsicWidth) {
@@ -2447,6 +2627,9 @@ Future<Codec> instantiateImageCodecFromBuffer(
 /// avoided, since it causes the image to use more memory than necessary.
 /// Instead, prefer scaling the [Canvas] transform.
 ///
+/// The [priority] argument orders the decode relative to other pending
+/// decodes. See [ImageDecodePriority].
+///
 /// The returned future can complete with an error if the image decoding has
 /// failed.
 ///
@@ -2459,16 +2642,18 @@ Future<Codec> instantiateImageCodecFromBuffer(
 Future<Codec> instantiateImageCodecWithSize(
   ImmutableBuffer buffer, {
   TargetImageSizeCallback? getTargetSize,
+  ImageDecodePriority priority = ImageDecodePriority.normal,
 }) async {
   getTargetSize ??= _getDefaultImageSize;
-  final ImageDescriptor descriptor = await ImageDescriptor.encoded(buffer);
+  final _NativeImageDescriptor descriptor = await ImageDescriptor.encoded(buffer) as _NativeImageDescriptor;
   try {
     final TargetImageSize targetSize = getTargetSize(descriptor.width, descriptor.height);
     assert(targetSize.width == null || targetSize.width! > 0);
     assert(targetSize.height == null || targetSize.height! > 0);
-    return descriptor.instantiateCodec(
+    return descriptor._instantiateCodecWithPriority(
       targetWidth: targetSize.width,
       targetHeight: targetSize.height,
+      priority: priority,
     );
   } finally {
     buffer.dispose();
@@ -7222,6 +7407,18 @@ base class _NativeImageDescriptor extends NativeFieldWrapperClass1 implements Im
 
   @override
   Future<Codec> instantiateCodec({int? targetWidth, int? targetHeight}) async {
+    return _instantiateCodecWithPriority(
+      targetWidth: targetWidth,
+      targetHeight: targetHeight,
+      priority: ImageDecodePriority.normal,
+    );
+  }
+
+  Codec _instantiateCodecWithPriority({
+    int? targetWidth,
+    int? targetHeight,
+    required ImageDecodePriority priority,
+  }) {
     if (targetWidth != null && targetWidth <= 0) {
       targetWidth = null;
     }
@@ -7241,12 +7438,12 @@ base class _NativeImageDescriptor extends NativeFieldWrapperClass1 implements Im
     assert(targetHeight != null);
 
     final Codec codec = _NativeCodec._();
-    _instantiateCodec(codec, targetWidth!, targetHeight!);
+    _instantiateCodec(codec, targetWidth!, targetHeight!, priority.index);
     return codec;
   }
 
-  @Native<Void Function(Pointer<Void>, Handle, Int32, Int32)>(symbol: 'ImageDescriptor::instantiateCodec')
-  external void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight);
+  @Native<Void Function(Pointer<Void>, Handle, Int32, Int32, Int32)>(symbol: 'ImageDescriptor::instantiateCodec')
+  external void _instantiateCodec(Codec outCodec, int targetWidth, int targetHeight, int priority);
 
   @override
   String toString() => 'ImageDescriptor(width: ${_width ?? '?'}, height: ${_height ?? '?'}, bytes per pixel: ${_bytesPerPixel ?? '?'})';
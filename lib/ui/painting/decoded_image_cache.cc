@@ -0,0 +1,204 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+DecodedImageCache* DecodedImageCache::GetCacheForProcess() {
+  static DecodedImageCache* cache = new DecodedImageCache();
+  return cache;
+}
+
+DecodedImageCache::DecodedImageCache() = default;
+
+DecodedImageCache::~DecodedImageCache() = default;
+
+DecodedImageCache::Key DecodedImageCache::MakeKey(const SkData& encoded,
+                                                  SkISize target_size,
+                                                  bool wide_gamut,
+                                                  const void* owner) {
+  std::string_view bytes(static_cast<const char*>(encoded.data()),
+                         encoded.size());
+  return Key{
+      .content_hash = std::hash<std::string_view>{}(bytes),
+      .content_size = encoded.size(),
+      .target_size = target_size,
+      .wide_gamut = wide_gamut,
+      .owner = owner,
+  };
+}
+
+DecodedImageCache::LookupResult DecodedImageCache::Lookup(
+    const Key& key,
+    const sk_sp<SkData>& encoded,
+    const std::weak_ptr<const void>& owner,
+    const ImageResult& result) {
+  sk_sp<DlImage> image;
+  {
+    std::scoped_lock lock(mutex_);
+    if (max_bytes_ == 0u) {
+      return LookupResult::kUncached;
+    }
+    RemoveExpiredEntriesLocked();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (!(it->key == key)) {
+        continue;
+      }
+      if (!it->encoded->equals(encoded.get())) {
+        return LookupResult::kUncached;
+      }
+      entries_.splice(entries_.begin(), entries_, it);
+      image = entries_.front().image;
+      break;
+    }
+
+    if (!image) {
+      for (auto& pending : pending_) {
+        if (!(pending.key == key)) {
+          continue;
+        }
+        if (pending.owner.expired() ||
+            !pending.encoded->equals(encoded.get())) {
+          return LookupResult::kUncached;
+        }
+        pending.waiters.push_back(result);
+        hit_count_++;
+        TraceStatsToTimelineLocked();
+        return LookupResult::kCoalesced;
+      }
+
+      pending_.push_back(PendingDecode{
+          .key = key,
+          .encoded = encoded,
+          .owner = owner,
+      });
+      miss_count_++;
+      TraceStatsToTimelineLocked();
+      return LookupResult::kMiss;
+    }
+
+    hit_count_++;
+    TraceStatsToTimelineLocked();
+  }
+  result(std::move(image), {});
+  return LookupResult::kHit;
+}
+
+void DecodedImageCache::Complete(const Key& key,
+                                 const sk_sp<DlImage>& image,
+                                 const std::string& decode_error) {
+  std::vector<ImageResult> waiters;
+  {
+    std::scoped_lock lock(mutex_);
+    auto pending = std::find_if(
+        pending_.begin(), pending_.end(),
+        [&key](const PendingDecode& decode) { return decode.key == key; });
+    if (pending == pending_.end()) {
+      return;
+    }
+    waiters = std::move(pending->waiters);
+
+    RemoveExpiredEntriesLocked();
+    size_t bytes =
+        image ? image->GetApproximateByteSize() + pending->encoded->size() : 0u;
+    if (image && bytes <= max_bytes_ && !pending->owner.expired()) {
+      EvictToBudgetLocked(max_bytes_ - bytes);
+      entries_.push_front(Entry{
+          .key = key,
+          .encoded = std::move(pending->encoded),
+          .owner = std::move(pending->owner),
+          .image = image,
+          .bytes = bytes,
+      });
+      cached_bytes_ += bytes;
+    }
+    pending_.erase(pending);
+    TraceStatsToTimelineLocked();
+  }
+  for (const auto& waiter : waiters) {
+    waiter(image, decode_error);
+  }
+}
+
+void DecodedImageCache::Purge() {
+  std::list<Entry> entries;
+  {
+    std::scoped_lock lock(mutex_);
+    entries.swap(entries_);
+    cached_bytes_ = 0u;
+    TraceStatsToTimelineLocked();
+  }
+  // The images are released outside of the lock.
+}
+
+void DecodedImageCache::PurgeOwner(const void* owner) {
+  std::list<Entry> entries;
+  {
+    std::scoped_lock lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      auto next = std::next(it);
+      if (it->key.owner == owner) {
+        cached_bytes_ -= it->bytes;
+        entries.splice(entries.end(), entries_, it);
+      }
+      it = next;
+    }
+    TraceStatsToTimelineLocked();
+  }
+  // The images are released outside of the lock.
+}
+
+void DecodedImageCache::SetMaxBytes(size_t max_bytes) {
+  std::scoped_lock lock(mutex_);
+  max_bytes_ = max_bytes;
+  RemoveExpiredEntriesLocked();
+  EvictToBudgetLocked(max_bytes_);
+}
+
+size_t DecodedImageCache::GetCachedBytes() const {
+  std::scoped_lock lock(mutex_);
+  return cached_bytes_;
+}
+
+size_t DecodedImageCache::GetCachedEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+void DecodedImageCache::RemoveExpiredEntriesLocked() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->owner.expired()) {
+      cached_bytes_ -= it->bytes;
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void DecodedImageCache::EvictToBudgetLocked(size_t max_bytes) {
+  while (!entries_.empty() && cached_bytes_ > max_bytes) {
+    cached_bytes_ -= entries_.back().bytes;
+    entries_.pop_back();
+  }
+}
+
+void DecodedImageCache::TraceStatsToTimelineLocked() const {
+#if !FLUTTER_RELEASE
+  FML_TRACE_COUNTER("flutter",                                          //
+                    "DecodedImageCache", reinterpret_cast<int64_t>(this),  //
+                    "Hits", hit_count_,                                    //
+                    "Misses", miss_count_,                                 //
+                    "Entries", entries_.size(),                            //
+                    "KBytes", cached_bytes_ / 1024u);
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace flutter
@@ -0,0 +1,165 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A process-wide cache of decoded images.
+///
+///             The same encoded image is often decoded many times at the same
+///             target size, across widgets, routes and even engines. Entries
+///             are keyed by a hash of the encoded bytes, the requested target
+///             size, the requested pixel format and the graphics context that
+///             owns the decoded texture. Hash matches are verified against the
+///             encoded bytes before a cached image is returned.
+///
+///             Concurrent requests for the same key are coalesced so that only
+///             the first request decodes the image.
+///
+///             The encoded bytes retained to verify hash matches count towards
+///             the budget along with the decoded images. A budget of zero
+///             disables the cache.
+///
+///             This class is thread safe.
+///
+class DecodedImageCache {
+ public:
+  using ImageResult = std::function<void(sk_sp<DlImage>, std::string)>;
+
+  static constexpr size_t kDefaultMaxBytes = 32u * 1024u * 1024u;
+
+  struct Key {
+    size_t content_hash = 0u;
+    size_t content_size = 0u;
+    SkISize target_size = SkISize::MakeEmpty();
+    bool wide_gamut = false;
+    const void* owner = nullptr;
+
+    bool operator==(const Key& other) const {
+      return content_hash == other.content_hash &&
+             content_size == other.content_size &&
+             target_size == other.target_size &&
+             wide_gamut == other.wide_gamut && owner == other.owner;
+    }
+  };
+
+  enum class LookupResult {
+    /// The result callback was invoked with the cached image.
+    kHit,
+    /// An identical decode is in flight. The result callback will be invoked
+    /// when it completes.
+    kCoalesced,
+    /// The caller must decode the image and report it via |Complete|.
+    kMiss,
+    /// The key collides with a different image. The caller must decode the
+    /// image without reporting it to the cache.
+    kUncached,
+  };
+
+  static DecodedImageCache* GetCacheForProcess();
+
+  DecodedImageCache();
+
+  ~DecodedImageCache();
+
+  static Key MakeKey(const SkData& encoded,
+                     SkISize target_size,
+                     bool wide_gamut,
+                     const void* owner);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Look up a decoded image.
+  ///
+  /// @param[in]  key      The key created by |MakeKey|.
+  /// @param[in]  encoded  The encoded bytes the key was created from.
+  /// @param[in]  owner    A reference to the object identified by
+  ///                      |Key::owner|. Entries are dropped once it is
+  ///                      collected.
+  /// @param[in]  result   The callback to invoke on a hit or when a coalesced
+  ///                      decode completes. It may be invoked on any thread.
+  ///
+  LookupResult Lookup(const Key& key,
+                      const sk_sp<SkData>& encoded,
+                      const std::weak_ptr<const void>& owner,
+                      const ImageResult& result);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Report the result of a decode that was a |LookupResult::kMiss|
+  ///             and invoke the callbacks of coalesced requests.
+  ///
+  void Complete(const Key& key,
+                const sk_sp<DlImage>& image,
+                const std::string& decode_error);
+
+  /// Evict all cached images. Called in response to low memory warnings.
+  void Purge();
+
+  /// Evict the cached images identified by |owner|. Called when the graphics
+  /// context that owns their textures shuts down, so that the textures do not
+  /// outlive it.
+  void PurgeOwner(const void* owner);
+
+  /// Set the maximum number of bytes of decoded images and their encoded
+  /// bytes to retain, or zero to disable the cache.
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t GetCachedBytes() const;
+
+  size_t GetCachedEntryCount() const;
+
+ private:
+  struct Entry {
+    Key key;
+    sk_sp<SkData> encoded;
+    std::weak_ptr<const void> owner;
+    sk_sp<DlImage> image;
+    // The size of the image and the encoded bytes.
+    size_t bytes = 0u;
+  };
+
+  struct PendingDecode {
+    Key key;
+    sk_sp<SkData> encoded;
+    std::weak_ptr<const void> owner;
+    std::vector<ImageResult> waiters;
+  };
+
+  mutable std::mutex mutex_;
+  // Ordered from most to least recently used.
+  std::list<Entry> entries_;
+  std::list<PendingDecode> pending_;
+  size_t max_bytes_ = kDefaultMaxBytes;
+  size_t cached_bytes_ = 0u;
+  size_t hit_count_ = 0u;
+  size_t miss_count_ = 0u;
+
+  // Drops the entries whose owner has been collected. Its address may since
+  // have been reused, and the cached textures are unusable anyway.
+  void RemoveExpiredEntriesLocked();
+
+  void EvictToBudgetLocked(size_t max_bytes);
+
+  void TraceStatsToTimelineLocked() const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_CACHE_H_
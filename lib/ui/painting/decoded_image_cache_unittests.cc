@@ -0,0 +1,199 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+
+#include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class MockDlImage : public DlImage {
+ public:
+  MOCK_METHOD(sk_sp<SkImage>, skia_image, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<impeller::Texture>,
+              impeller_texture,
+              (),
+              (const, override));
+  MOCK_METHOD(bool, isOpaque, (), (const, override));
+  MOCK_METHOD(bool, isTextureBacked, (), (const, override));
+  MOCK_METHOD(bool, isUIThreadSafe, (), (const, override));
+  MOCK_METHOD(SkISize, dimensions, (), (const, override));
+  MOCK_METHOD(size_t, GetApproximateByteSize, (), (const, override));
+};
+
+sk_sp<DlImage> MakeImage(size_t bytes) {
+  auto image = sk_make_sp<::testing::NiceMock<MockDlImage>>();
+  ON_CALL(*image, GetApproximateByteSize)
+      .WillByDefault(::testing::Return(bytes));
+  return image;
+}
+
+sk_sp<SkData> MakeEncoded(const char* contents) {
+  return SkData::MakeWithCString(contents);
+}
+
+}  // namespace
+
+TEST(DecodedImageCacheTest, ReturnsCachedImageForSameContents) {
+  DecodedImageCache cache;
+  auto owner = std::make_shared<int>(0);
+  auto first_data = MakeEncoded("image");
+  auto second_data = MakeEncoded("image");
+  auto key = DecodedImageCache::MakeKey(*first_data, SkISize::Make(10, 10),
+                                        false, owner.get());
+  EXPECT_EQ(key, DecodedImageCache::MakeKey(*second_data,
+                                            SkISize::Make(10, 10), false,
+                                            owner.get()));
+
+  EXPECT_EQ(cache.Lookup(key, first_data, owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kMiss);
+  auto image = MakeImage(100);
+  cache.Complete(key, image, {});
+  EXPECT_EQ(cache.GetCachedEntryCount(), 1u);
+  // The encoded bytes retained for verification count towards the budget.
+  EXPECT_EQ(cache.GetCachedBytes(), 100u + first_data->size());
+
+  sk_sp<DlImage> result;
+  EXPECT_EQ(cache.Lookup(key, second_data, owner,
+                         [&result](sk_sp<DlImage> image, const std::string&) {
+                           result = std::move(image);
+                         }),
+            DecodedImageCache::LookupResult::kHit);
+  EXPECT_EQ(result, image);
+}
+
+TEST(DecodedImageCacheTest, CoalescesConcurrentRequests) {
+  DecodedImageCache cache;
+  auto owner = std::make_shared<int>(0);
+  auto data = MakeEncoded("image");
+  auto key = DecodedImageCache::MakeKey(*data, SkISize::Make(10, 10), false,
+                                        owner.get());
+
+  EXPECT_EQ(cache.Lookup(key, data, owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kMiss);
+  int waiter_count = 0;
+  auto waiter = [&waiter_count](const sk_sp<DlImage>& image,
+                                const std::string&) {
+    EXPECT_TRUE(image);
+    waiter_count++;
+  };
+  EXPECT_EQ(cache.Lookup(key, data, owner, waiter),
+            DecodedImageCache::LookupResult::kCoalesced);
+  EXPECT_EQ(cache.Lookup(key, data, owner, waiter),
+            DecodedImageCache::LookupResult::kCoalesced);
+
+  cache.Complete(key, MakeImage(100), {});
+  EXPECT_EQ(waiter_count, 2);
+}
+
+TEST(DecodedImageCacheTest, EvictsLeastRecentlyUsedImagesOverBudget) {
+  DecodedImageCache cache;
+  cache.SetMaxBytes(250);
+  auto owner = std::make_shared<int>(0);
+  std::vector<DecodedImageCache::Key> keys;
+  for (const char* contents : {"a", "b", "c"}) {
+    auto data = MakeEncoded(contents);
+    auto key = DecodedImageCache::MakeKey(*data, SkISize::Make(10, 10), false,
+                                          owner.get());
+    ASSERT_EQ(cache.Lookup(key, data, owner, [](auto, auto) {}),
+              DecodedImageCache::LookupResult::kMiss);
+    cache.Complete(key, MakeImage(100), {});
+    keys.push_back(key);
+  }
+
+  EXPECT_EQ(cache.GetCachedEntryCount(), 2u);
+  EXPECT_EQ(cache.GetCachedBytes(), 2u * (100u + MakeEncoded("a")->size()));
+  // The first image was evicted.
+  EXPECT_EQ(cache.Lookup(keys[0], MakeEncoded("a"), owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kMiss);
+  cache.Complete(keys[0], nullptr, "error");
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetCachedEntryCount(), 0u);
+  EXPECT_EQ(cache.GetCachedBytes(), 0u);
+}
+
+TEST(DecodedImageCacheTest, DropsImagesOfCollectedOwners) {
+  DecodedImageCache cache;
+  auto owner = std::make_shared<int>(0);
+  auto data = MakeEncoded("image");
+  auto key = DecodedImageCache::MakeKey(*data, SkISize::Make(10, 10), false,
+                                        owner.get());
+  ASSERT_EQ(cache.Lookup(key, data, owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kMiss);
+  cache.Complete(key, MakeImage(100), {});
+
+  std::weak_ptr<const void> collected = owner;
+  owner.reset();
+  EXPECT_EQ(cache.Lookup(key, data, collected, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kMiss);
+  EXPECT_EQ(cache.GetCachedEntryCount(), 0u);
+}
+
+TEST(DecodedImageCacheTest, RemovesImagesOfCollectedOwnersOnEveryLookup) {
+  DecodedImageCache cache;
+  auto owner = std::make_shared<int>(0);
+  auto data = MakeEncoded("image");
+  auto key = DecodedImageCache::MakeKey(*data, SkISize::Make(10, 10), false,
+                                        owner.get());
+  ASSERT_EQ(cache.Lookup(key, data, owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kMiss);
+  cache.Complete(key, MakeImage(100), {});
+  owner.reset();
+
+  // A lookup of an unrelated image drops the image of the collected owner.
+  auto other_owner = std::make_shared<int>(0);
+  auto other_data = MakeEncoded("other");
+  auto other_key = DecodedImageCache::MakeKey(
+      *other_data, SkISize::Make(10, 10), false, other_owner.get());
+  EXPECT_EQ(cache.Lookup(other_key, other_data, other_owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kMiss);
+  EXPECT_EQ(cache.GetCachedEntryCount(), 0u);
+  EXPECT_EQ(cache.GetCachedBytes(), 0u);
+}
+
+TEST(DecodedImageCacheTest, PurgesImagesOfOwner) {
+  DecodedImageCache cache;
+  auto first_owner = std::make_shared<int>(0);
+  auto second_owner = std::make_shared<int>(0);
+  auto data = MakeEncoded("image");
+  for (const auto& owner : {first_owner, second_owner}) {
+    auto key = DecodedImageCache::MakeKey(*data, SkISize::Make(10, 10), false,
+                                          owner.get());
+    ASSERT_EQ(cache.Lookup(key, data, owner, [](auto, auto) {}),
+              DecodedImageCache::LookupResult::kMiss);
+    cache.Complete(key, MakeImage(100), {});
+  }
+  ASSERT_EQ(cache.GetCachedEntryCount(), 2u);
+
+  cache.PurgeOwner(first_owner.get());
+  EXPECT_EQ(cache.GetCachedEntryCount(), 1u);
+  EXPECT_EQ(cache.GetCachedBytes(), 100u + data->size());
+  auto key = DecodedImageCache::MakeKey(*data, SkISize::Make(10, 10), false,
+                                        second_owner.get());
+  EXPECT_EQ(cache.Lookup(key, data, second_owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kHit);
+}
+
+TEST(DecodedImageCacheTest, ZeroBudgetDisablesCache) {
+  DecodedImageCache cache;
+  cache.SetMaxBytes(0u);
+  auto owner = std::make_shared<int>(0);
+  auto data = MakeEncoded("image");
+  auto key = DecodedImageCache::MakeKey(*data, SkISize::Make(10, 10), false,
+                                        owner.get());
+  EXPECT_EQ(cache.Lookup(key, data, owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kUncached);
+  EXPECT_EQ(cache.Lookup(key, data, owner, [](auto, auto) {}),
+            DecodedImageCache::LookupResult::kUncached);
+  EXPECT_EQ(cache.GetCachedEntryCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,320 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_disk_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/hex_codec.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/paths.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/shell/version/version.h"
+#include "openssl/sha.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+
+namespace flutter {
+
+std::string DecodedImageDiskCache::cache_base_path_;
+
+namespace {
+
+constexpr char kEngineComponent[] = "flutter_engine";
+
+fml::UniqueFD OpenCacheDirectory(const std::string& cache_base_path) {
+  fml::UniqueFD cache_base_dir;
+  if (cache_base_path.length()) {
+    cache_base_dir = fml::OpenDirectory(cache_base_path.c_str(), false,
+                                        fml::FilePermission::kRead);
+  } else {
+    cache_base_dir = fml::paths::GetCachesDirectory();
+  }
+  if (!cache_base_dir.is_valid()) {
+    return {};
+  }
+  return fml::CreateDirectory(
+      cache_base_dir,
+      {kEngineComponent, GetFlutterEngineVersion(),
+       DecodedImageDiskCache::kDirectoryName},
+      fml::FilePermission::kReadWrite);
+}
+
+bool IsSupportedColorType(SkColorType color_type) {
+  switch (color_type) {
+    case kRGBA_8888_SkColorType:
+    case kRGBA_F16_SkColorType:
+    case kBGR_101010x_XR_SkColorType:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsSupportedAlphaType(SkAlphaType alpha_type) {
+  return alpha_type == kOpaque_SkAlphaType || alpha_type == kPremul_SkAlphaType;
+}
+
+}  // namespace
+
+void DecodedImageDiskCache::SetCacheDirectoryPath(std::string path) {
+  cache_base_path_ = std::move(path);
+}
+
+DecodedImageDiskCache* DecodedImageDiskCache::GetCacheForProcess() {
+  static DecodedImageDiskCache* cache =
+      new DecodedImageDiskCache(OpenCacheDirectory(cache_base_path_));
+  return cache;
+}
+
+DecodedImageDiskCache::DecodedImageDiskCache(fml::UniqueFD directory,
+                                             size_t max_bytes)
+    : directory_(std::move(directory)), max_bytes_(max_bytes) {
+  if (!IsValid()) {
+    FML_LOG(WARNING) << "Could not acquire the decoded image cache directory. "
+                        "Caching of decoded images on disk is disabled.";
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  LoadIndexLocked();
+}
+
+DecodedImageDiskCache::~DecodedImageDiskCache() = default;
+
+bool DecodedImageDiskCache::IsValid() const {
+  return directory_.is_valid();
+}
+
+DecodedImageDiskCache::Key DecodedImageDiskCache::MakeKey(
+    const SkData& encoded,
+    SkISize target_size,
+    bool wide_gamut) {
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  SHA256(encoded.bytes(), encoded.size(), digest);
+  return {
+      .content_digest = fml::HexEncode(std::string_view(
+          reinterpret_cast<const char*>(digest), SHA256_DIGEST_LENGTH)),
+      .target_size = target_size,
+      .wide_gamut = wide_gamut,
+  };
+}
+
+std::string DecodedImageDiskCache::GetFileName(const Key& key) {
+  std::stringstream stream;
+  stream << key.content_digest << "_" << key.target_size.width() << "x"
+         << key.target_size.height() << (key.wide_gamut ? "_wide" : "");
+  return stream.str();
+}
+
+std::unique_ptr<fml::Mapping> DecodedImageDiskCache::Load(const Key& key,
+                                                          SkPixmap* pixmap) {
+  if (!IsValid()) {
+    return nullptr;
+  }
+  TRACE_EVENT0("flutter", "DecodedImageDiskCache::Load");
+  const std::string file_name = GetFileName(key);
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = FindEntryLocked(file_name);
+    if (found == entries_.end()) {
+      return nullptr;
+    }
+    // The new order is persisted with the index on the next store.
+    entries_.splice(entries_.begin(), entries_, found);
+  }
+
+  auto file = fml::OpenFileReadOnly(directory_, file_name.c_str());
+  if (!file.is_valid()) {
+    return nullptr;
+  }
+  auto mapping = std::make_unique<fml::FileMapping>(file);
+  if (mapping->GetSize() < sizeof(EntryHeader)) {
+    return nullptr;
+  }
+  EntryHeader header;
+  memcpy(&header, mapping->GetMapping(), sizeof(EntryHeader));
+  if (header.signature != EntryHeader::kSignature ||
+      header.version != EntryHeader::kVersion1) {
+    FML_LOG(INFO) << "Decoded image cache header is corrupt: " << file_name;
+    return nullptr;
+  }
+  const auto color_type = static_cast<SkColorType>(header.color_type);
+  const auto alpha_type = static_cast<SkAlphaType>(header.alpha_type);
+  if (!IsSupportedColorType(color_type) || !IsSupportedAlphaType(alpha_type) ||
+      header.width <= 0 || header.height <= 0) {
+    FML_LOG(INFO) << "Decoded image cache header is corrupt: " << file_name;
+    return nullptr;
+  }
+  const SkImageInfo info =
+      SkImageInfo::Make(header.width, header.height, color_type, alpha_type,
+                        SkColorSpace::MakeSRGB());
+  const size_t row_bytes = header.row_bytes;
+  if (!info.validRowBytes(row_bytes) ||
+      mapping->GetSize() - sizeof(EntryHeader) <
+          info.computeByteSize(row_bytes)) {
+    FML_LOG(INFO) << "Decoded image cache size is corrupt: " << file_name;
+    return nullptr;
+  }
+  pixmap->reset(info, mapping->GetMapping() + sizeof(EntryHeader), row_bytes);
+  return mapping;
+}
+
+bool DecodedImageDiskCache::Store(const Key& key, const SkPixmap& pixmap) {
+  if (!IsValid() || !pixmap.addr() ||
+      !IsSupportedColorType(pixmap.colorType()) ||
+      !IsSupportedAlphaType(pixmap.alphaType())) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "DecodedImageDiskCache::Store");
+
+  const SkImageInfo& info = pixmap.info();
+  const size_t row_bytes = info.minRowBytes();
+  const size_t total_size =
+      sizeof(EntryHeader) + info.computeByteSize(row_bytes);
+  // Large entries would evict most of the cache.
+  if (total_size > max_bytes_ / 4) {
+    return false;
+  }
+
+  const std::string file_name = GetFileName(key);
+  {
+    std::scoped_lock lock(mutex_);
+    if (!pending_stores_.insert(file_name).second) {
+      return false;
+    }
+  }
+
+  uint8_t* buffer = static_cast<uint8_t*>(malloc(total_size));
+  bool written = false;
+  if (buffer) {
+    fml::MallocMapping mapping(buffer, total_size);
+    EntryHeader header;
+    header.width = info.width();
+    header.height = info.height();
+    header.color_type = info.colorType();
+    header.alpha_type = info.alphaType();
+    header.row_bytes = row_bytes;
+    memcpy(buffer, &header, sizeof(EntryHeader));
+    written =
+        pixmap.readPixels(info, buffer + sizeof(EntryHeader), row_bytes) &&
+        fml::WriteAtomically(directory_, file_name.c_str(), mapping);
+  }
+  if (!written) {
+    FML_LOG(WARNING) << "Could not write decoded image to the disk cache.";
+  }
+
+  std::scoped_lock lock(mutex_);
+  pending_stores_.erase(file_name);
+  if (!written) {
+    return false;
+  }
+  auto found = FindEntryLocked(file_name);
+  if (found != entries_.end()) {
+    cached_bytes_ -= found->bytes;
+    entries_.erase(found);
+  }
+  entries_.push_front({.file_name = file_name, .bytes = total_size});
+  cached_bytes_ += total_size;
+  EvictToBudgetLocked(max_bytes_);
+  WriteIndexLocked();
+  return true;
+}
+
+void DecodedImageDiskCache::Purge() {
+  if (!IsValid()) {
+    return;
+  }
+  std::scoped_lock lock(mutex_);
+  EvictToBudgetLocked(0u);
+  WriteIndexLocked();
+}
+
+size_t DecodedImageDiskCache::GetCachedBytes() const {
+  std::scoped_lock lock(mutex_);
+  return cached_bytes_;
+}
+
+size_t DecodedImageDiskCache::GetCachedEntryCount() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+void DecodedImageDiskCache::LoadIndexLocked() {
+  // The index holds one line with the file name and the size of each entry,
+  // ordered from most to least recently used.
+  auto index_file = fml::OpenFileReadOnly(directory_, kIndexFileName);
+  if (index_file.is_valid()) {
+    fml::FileMapping mapping(index_file);
+    if (mapping.GetMapping()) {
+      std::istringstream stream(
+          std::string(reinterpret_cast<const char*>(mapping.GetMapping()),
+                      mapping.GetSize()));
+      std::string file_name;
+      size_t bytes = 0u;
+      while (stream >> file_name >> bytes) {
+        if (fml::FileExists(directory_, file_name.c_str())) {
+          entries_.push_back({.file_name = file_name, .bytes = bytes});
+          cached_bytes_ += bytes;
+        }
+      }
+    }
+  }
+
+  // Remove the files of entries that were written but never recorded in the
+  // index, as well as temporary files of interrupted writes.
+  fml::VisitFiles(directory_, [this](const fml::UniqueFD& directory,
+                                     const std::string& file_name) {
+    if (file_name == kIndexFileName ||
+        fml::IsDirectory(directory, file_name.c_str())) {
+      return true;
+    }
+    if (FindEntryLocked(file_name) == entries_.end()) {
+      fml::UnlinkFile(directory, file_name.c_str());
+    }
+    return true;
+  });
+
+  EvictToBudgetLocked(max_bytes_);
+}
+
+bool DecodedImageDiskCache::WriteIndexLocked() const {
+  if (entries_.empty()) {
+    return !fml::FileExists(directory_, kIndexFileName) ||
+           fml::UnlinkFile(directory_, kIndexFileName);
+  }
+  std::stringstream stream;
+  for (const auto& entry : entries_) {
+    stream << entry.file_name << " " << entry.bytes << "\n";
+  }
+  fml::DataMapping mapping(stream.str());
+  if (!fml::WriteAtomically(directory_, kIndexFileName, mapping)) {
+    FML_LOG(WARNING) << "Could not write the decoded image cache index.";
+    return false;
+  }
+  return true;
+}
+
+std::list<DecodedImageDiskCache::Entry>::iterator
+DecodedImageDiskCache::FindEntryLocked(const std::string& file_name) {
+  return std::find_if(entries_.begin(), entries_.end(),
+                      [&file_name](const Entry& entry) {
+                        return entry.file_name == file_name;
+                      });
+}
+
+void DecodedImageDiskCache::EvictToBudgetLocked(size_t max_bytes) {
+  while (!entries_.empty() && cached_bytes_ > max_bytes) {
+    const Entry& entry = entries_.back();
+    fml::UnlinkFile(directory_, entry.file_name.c_str());
+    cached_bytes_ -= entry.bytes;
+    entries_.pop_back();
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,156 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_DISK_CACHE_H_
+#define FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_DISK_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of decoded image pixels that persists across launches.
+///
+///             Decoding large images with expensive codecs can dominate the
+///             time to first content on cold starts. Images that took long to
+///             decode are written to disk after they are uploaded so that
+///             later launches can copy the pixels from a memory mapped file
+///             instead of decoding them again.
+///
+///             Entries are stored in the engine version specific directory
+///             also used by `PersistentCache`. Entries and the index that
+///             records their least recently used order are written
+///             atomically. Files that are not recorded in the index, for
+///             instance because the process died before the index was
+///             updated, are removed when the cache is opened.
+///
+///             This class is thread safe.
+///
+class DecodedImageDiskCache {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 64u * 1024u * 1024u;
+
+  /// Decodes that complete faster than this are not worth the disk space and
+  /// the I/O of a cache entry.
+  static constexpr fml::TimeDelta kMinDecodeDuration =
+      fml::TimeDelta::FromMilliseconds(8);
+
+  static constexpr char kDirectoryName[] = "decoded_images";
+
+  struct Key {
+    // A digest of the encoded bytes.
+    std::string content_digest;
+    SkISize target_size = SkISize::MakeEmpty();
+    bool wide_gamut = false;
+  };
+
+  // This must be called before |GetCacheForProcess|. Otherwise, it won't
+  // affect the cache directory returned by |GetCacheForProcess|.
+  static void SetCacheDirectoryPath(std::string path);
+
+  static DecodedImageDiskCache* GetCacheForProcess();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Opens a cache in the given directory and removes the files of
+  ///             entries that are not recorded in its index.
+  ///
+  explicit DecodedImageDiskCache(fml::UniqueFD directory,
+                                 size_t max_bytes = kDefaultMaxBytes);
+
+  ~DecodedImageDiskCache();
+
+  bool IsValid() const;
+
+  static Key MakeKey(const SkData& encoded,
+                     SkISize target_size,
+                     bool wide_gamut);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Look up the pixels stored for a key.
+  ///
+  /// @param[in]  key     The key created by |MakeKey|.
+  /// @param[out] pixmap  On success, describes the cached pixels. The pixels
+  ///                     are only valid as long as the returned mapping.
+  ///
+  /// @return     The mapping of the cache entry or nullptr on a cache miss.
+  ///
+  std::unique_ptr<fml::Mapping> Load(const Key& key, SkPixmap* pixmap);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Write the pixels of a decoded image to the cache and evict
+  ///             the least recently used entries that no longer fit. This
+  ///             performs blocking I/O.
+  ///
+  /// @return     Whether the entry was written.
+  ///
+  bool Store(const Key& key, const SkPixmap& pixmap);
+
+  /// Remove all entries.
+  void Purge();
+
+  size_t GetCachedBytes() const;
+
+  size_t GetCachedEntryCount() const;
+
+ private:
+  // Header written into the files used to store cached images.
+  struct EntryHeader {
+    static const uint32_t kSignature = 0x44494D47;
+    static const uint32_t kVersion1 = 1;
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion1;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t color_type = 0;
+    int32_t alpha_type = 0;
+    uint64_t row_bytes = 0;
+  };
+
+  struct Entry {
+    std::string file_name;
+    size_t bytes = 0u;
+  };
+
+  static constexpr char kIndexFileName[] = "index";
+
+  static std::string cache_base_path_;
+
+  const fml::UniqueFD directory_;
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  // Ordered from most to least recently used.
+  std::list<Entry> entries_;
+  size_t cached_bytes_ = 0u;
+  // Names of the entries that are being written.
+  std::set<std::string> pending_stores_;
+
+  static std::string GetFileName(const Key& key);
+
+  void LoadIndexLocked();
+
+  bool WriteIndexLocked() const;
+
+  std::list<Entry>::iterator FindEntryLocked(const std::string& file_name);
+
+  void EvictToBudgetLocked(size_t max_bytes);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DecodedImageDiskCache);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_DECODED_IMAGE_DISK_CACHE_H_
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/decoded_image_disk_cache.h"
+
+#include "flutter/fml/file.h"
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+fml::UniqueFD OpenDirectory(const fml::ScopedTemporaryDirectory& directory) {
+  return fml::OpenDirectory(directory.path().c_str(), false,
+                            fml::FilePermission::kReadWrite);
+}
+
+SkBitmap MakeBitmap(SkColor color) {
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType,
+                                       kPremul_SkAlphaType));
+  bitmap.eraseColor(color);
+  return bitmap;
+}
+
+DecodedImageDiskCache::Key MakeKey(const char* contents) {
+  return DecodedImageDiskCache::MakeKey(*SkData::MakeWithCString(contents),
+                                        SkISize::Make(16, 16), false);
+}
+
+// The size of a cache entry holding a bitmap made by |MakeBitmap|.
+constexpr size_t kEntryBytes = 32u + 16u * 16u * 4u;
+
+}  // namespace
+
+TEST(DecodedImageDiskCacheTest, LoadsPixelsStoredByPreviousCache) {
+  fml::ScopedTemporaryDirectory directory;
+  {
+    DecodedImageDiskCache cache(OpenDirectory(directory));
+    ASSERT_TRUE(cache.IsValid());
+    ASSERT_TRUE(
+        cache.Store(MakeKey("image"), MakeBitmap(SK_ColorRED).pixmap()));
+  }
+
+  DecodedImageDiskCache cache(OpenDirectory(directory));
+  EXPECT_EQ(cache.GetCachedEntryCount(), 1u);
+
+  SkPixmap pixmap;
+  EXPECT_EQ(cache.Load(MakeKey("other image"), &pixmap), nullptr);
+  auto mapping = cache.Load(MakeKey("image"), &pixmap);
+  ASSERT_NE(mapping, nullptr);
+  EXPECT_EQ(pixmap.dimensions(), SkISize::Make(16, 16));
+  EXPECT_EQ(pixmap.getColor(8, 8), SK_ColorRED);
+}
+
+TEST(DecodedImageDiskCacheTest, EvictsLeastRecentlyUsedEntries) {
+  fml::ScopedTemporaryDirectory directory;
+  DecodedImageDiskCache cache(OpenDirectory(directory), 4u * kEntryBytes);
+  for (const char* contents : {"a", "b", "c", "d"}) {
+    ASSERT_TRUE(
+        cache.Store(MakeKey(contents), MakeBitmap(SK_ColorRED).pixmap()));
+  }
+  EXPECT_EQ(cache.GetCachedBytes(), 4u * kEntryBytes);
+
+  SkPixmap pixmap;
+  ASSERT_NE(cache.Load(MakeKey("a"), &pixmap), nullptr);
+  ASSERT_TRUE(cache.Store(MakeKey("e"), MakeBitmap(SK_ColorRED).pixmap()));
+
+  EXPECT_EQ(cache.GetCachedEntryCount(), 4u);
+  EXPECT_NE(cache.Load(MakeKey("a"), &pixmap), nullptr);
+  EXPECT_EQ(cache.Load(MakeKey("b"), &pixmap), nullptr);
+
+  cache.Purge();
+  EXPECT_EQ(cache.GetCachedEntryCount(), 0u);
+  EXPECT_EQ(cache.GetCachedBytes(), 0u);
+}
+
+TEST(DecodedImageDiskCacheTest, RemovesFilesMissingFromIndex) {
+  fml::ScopedTemporaryDirectory directory;
+  fml::DataMapping contents(std::string("stray"));
+  ASSERT_TRUE(fml::WriteAtomically(directory.fd(), "stray", contents));
+
+  DecodedImageDiskCache cache(OpenDirectory(directory));
+  EXPECT_EQ(cache.GetCachedEntryCount(), 0u);
+  EXPECT_FALSE(fml::FileExists(directory.fd(), "stray"));
+}
+
+}  // namespace testing
+}  // namespace flutter
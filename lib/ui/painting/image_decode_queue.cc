@@ -0,0 +1,77 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decode_queue.h"
+
+#include <utility>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+ImageDecodeQueue::ImageDecodeQueue(std::shared_ptr<fml::BasicTaskRunner> runner)
+    : runner_(std::move(runner)) {
+  FML_DCHECK(runner_);
+}
+
+ImageDecodeQueue::~ImageDecodeQueue() = default;
+
+bool ImageDecodeQueue::RunsAfter::operator()(const Job& a, const Job& b) const {
+  if (a.priority != b.priority) {
+    return a.priority < b.priority;
+  }
+  return a.sequence > b.sequence;
+}
+
+void ImageDecodeQueue::Push(ImageDecodePriority priority,
+                            std::shared_ptr<const std::atomic_bool> cancelled,
+                            fml::closure task,
+                            fml::closure on_cancelled) {
+  FML_DCHECK(task);
+  FML_DCHECK(on_cancelled);
+  {
+    std::scoped_lock lock(mutex_);
+    jobs_.push({
+        .priority = priority,
+        .sequence = next_sequence_++,
+        .cancelled = std::move(cancelled),
+        .task = std::move(task),
+        .on_cancelled = std::move(on_cancelled),
+    });
+  }
+  // The queue must outlive the posted task so that the job it runs is always
+  // serviced, even if the decoder that queued it has been collected.
+  runner_->PostTask([queue = shared_from_this()]() { queue->RunNextJob(); });
+}
+
+size_t ImageDecodeQueue::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  return jobs_.size();
+}
+
+void ImageDecodeQueue::RunNextJob() {
+  // Skipping a cancelled job doesn't use up this task. One task is posted per
+  // job, so the tasks left over from skipped jobs find the queue empty.
+  while (true) {
+    Job job;
+    {
+      std::scoped_lock lock(mutex_);
+      if (jobs_.empty()) {
+        return;
+      }
+      job = jobs_.top();
+      jobs_.pop();
+    }
+    if (job.cancelled && job.cancelled->load()) {
+      TRACE_EVENT0("flutter", "ImageDecodeQueue::SkipCancelledDecode");
+      job.on_cancelled();
+      continue;
+    }
+    job.task();
+    return;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_QUEUE_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "flutter/fml/closure.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/task_runner.h"
+
+namespace flutter {
+
+// This must be kept in sync with the `ImageDecodePriority` enum in
+// painting.dart.
+enum class ImageDecodePriority {
+  // Decodes of images that are not on screen yet, such as prefetches.
+  kLow,
+  kNormal,
+  // Decodes of images that the next frame is waiting for.
+  kHigh,
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Orders the decodes posted to the concurrent worker runner.
+///
+///             Every decode posts a task to the runner, but the task runs the
+///             queued decode with the highest priority instead of the decode
+///             that posted it. Decodes of the same priority run in the order
+///             they were queued. Decodes that were cancelled before a worker
+///             picked them up are skipped.
+///
+///             This class is thread safe.
+///
+class ImageDecodeQueue : public std::enable_shared_from_this<ImageDecodeQueue> {
+ public:
+  explicit ImageDecodeQueue(std::shared_ptr<fml::BasicTaskRunner> runner);
+
+  ~ImageDecodeQueue();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Queue a decode.
+  ///
+  /// @param[in]  priority      The priority of the decode.
+  /// @param[in]  cancelled     An optional flag that is set by the owner of the
+  ///                           decode once its result is no longer needed.
+  /// @param[in]  task          The decode. Invoked on the worker runner.
+  /// @param[in]  on_cancelled  Invoked on the worker runner instead of |task|
+  ///                           if the decode was cancelled before it started.
+  ///
+  void Push(ImageDecodePriority priority,
+            std::shared_ptr<const std::atomic_bool> cancelled,
+            fml::closure task,
+            fml::closure on_cancelled);
+
+  /// The number of decodes that have not been picked up by a worker yet.
+  size_t GetPendingCount() const;
+
+ private:
+  struct Job {
+    ImageDecodePriority priority;
+    // Breaks ties between jobs of the same priority in queueing order.
+    uint64_t sequence;
+    std::shared_ptr<const std::atomic_bool> cancelled;
+    fml::closure task;
+    fml::closure on_cancelled;
+  };
+
+  // Whether |a| runs after |b|. |std::priority_queue| keeps the job that runs
+  // before all others on top.
+  struct RunsAfter {
+    bool operator()(const Job& a, const Job& b) const;
+  };
+
+  const std::shared_ptr<fml::BasicTaskRunner> runner_;
+  mutable std::mutex mutex_;
+  std::priority_queue<Job, std::vector<Job>, RunsAfter> jobs_;
+  uint64_t next_sequence_ = 0;
+
+  void RunNextJob();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ImageDecodeQueue);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_DECODE_QUEUE_H_
@@ -0,0 +1,84 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_decode_queue.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// Runs the posted tasks when asked to, like a worker that was busy.
+class ManualTaskRunner : public fml::BasicTaskRunner {
+ public:
+  void PostTask(const fml::closure& task) override { tasks_.push_back(task); }
+
+  size_t GetPostedTaskCount() const { return tasks_.size(); }
+
+  void RunPostedTasks() {
+    auto tasks = std::move(tasks_);
+    tasks_.clear();
+    for (const auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<fml::closure> tasks_;
+};
+
+}  // namespace
+
+TEST(ImageDecodeQueueTest, RunsDecodesInPriorityOrder) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto queue = std::make_shared<ImageDecodeQueue>(runner);
+  std::vector<std::string> decoded;
+  auto push = [&](ImageDecodePriority priority, const std::string& name) {
+    queue->Push(
+        priority, nullptr, [&decoded, name]() { decoded.push_back(name); },
+        []() { FAIL(); });
+  };
+  push(ImageDecodePriority::kLow, "prefetch");
+  push(ImageDecodePriority::kNormal, "first");
+  push(ImageDecodePriority::kHigh, "visible");
+  push(ImageDecodePriority::kNormal, "second");
+  EXPECT_EQ(queue->GetPendingCount(), 4u);
+  EXPECT_EQ(runner->GetPostedTaskCount(), 4u);
+
+  runner->RunPostedTasks();
+  EXPECT_EQ(decoded, (std::vector<std::string>{"visible", "first", "second",
+                                               "prefetch"}));
+  EXPECT_EQ(queue->GetPendingCount(), 0u);
+}
+
+TEST(ImageDecodeQueueTest, SkipsCancelledDecodes) {
+  auto runner = std::make_shared<ManualTaskRunner>();
+  auto queue = std::make_shared<ImageDecodeQueue>(runner);
+  auto cancelled = std::make_shared<std::atomic_bool>(false);
+  int decoded = 0;
+  int skipped = 0;
+  for (int i = 0; i < 2; i++) {
+    queue->Push(
+        ImageDecodePriority::kHigh, cancelled, [&decoded]() { decoded++; },
+        [&skipped]() { skipped++; });
+  }
+  queue->Push(
+      ImageDecodePriority::kLow, nullptr, [&decoded]() { decoded++; },
+      [&skipped]() { skipped++; });
+  cancelled->store(true);
+
+  // The first task skips both cancelled decodes and runs the remaining one.
+  runner->RunPostedTasks();
+  EXPECT_EQ(decoded, 1);
+  EXPECT_EQ(skipped, 2);
+  EXPECT_EQ(queue->GetPendingCount(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
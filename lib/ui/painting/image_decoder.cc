@@ -25,7 +25,8 @@ std::unique_ptr<ImageDecoder> ImageDecoder::Make(
         std::move(concurrent_task_runner),  //
         std::move(io_manager),              //
         settings.enable_wide_gamut,         //
-        gpu_disabled_switch);
+        gpu_disabled_switch,                //
+        settings.enable_decoded_image_disk_cache);
   }
 #endif  // IMPELLER_SUPPORTS_RENDERING
 #if !SLIMPELLER
@@ -47,6 +48,8 @@ ImageDecoder::ImageDecoder(
     : runners_(runners),
       concurrent_task_runner_(std::move(concurrent_task_runner)),
       io_manager_(std::move(io_manager)),
+      decode_queue_(
+          std::make_shared<ImageDecodeQueue>(concurrent_task_runner_)),
       weak_factory_(this) {
   FML_DCHECK(runners_.IsValid());
   FML_DCHECK(runners_.GetUITaskRunner()->RunsTasksOnCurrentThread())
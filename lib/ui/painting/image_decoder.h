@@ -12,6 +12,7 @@
 #include "flutter/display_list/image/dl_image.h"
 #include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/lib/ui/io_manager.h"
+#include "flutter/lib/ui/painting/image_decode_queue.h"
 #include "flutter/lib/ui/painting/image_descriptor.h"
 
 namespace flutter {
@@ -34,15 +35,23 @@ class ImageDecoder {
 
   using ImageResult = std::function<void(sk_sp<DlImage>, std::string)>;
 
+  struct Options {
+    ImageDecodePriority priority = ImageDecodePriority::kNormal;
+    // When set before a worker starts the decode, the decode is skipped and
+    // the result is invoked with a null image.
+    std::shared_ptr<const std::atomic_bool> cancelled;
+  };
+
   // Takes an image descriptor and returns a handle to a texture resident on the
   // GPU. All image decompression and resizes are done on a worker thread
-  // concurrently. Texture upload is done on the IO thread and the result
-  // returned back on the UI thread. On error, the texture is null but the
-  // callback is guaranteed to return on the UI thread.
+  // concurrently, in the order of their priority. Texture upload is done on
+  // the IO thread and the result returned back on the UI thread. On error, the
+  // texture is null but the callback is guaranteed to return on the UI thread.
   virtual void Decode(fml::RefPtr<ImageDescriptor> descriptor,
                       uint32_t target_width,
                       uint32_t target_height,
-                      const ImageResult& result) = 0;
+                      const ImageResult& result,
+                      const Options& options = {}) = 0;
 
   fml::WeakPtr<ImageDecoder> GetWeakPtr() const;
 
@@ -50,6 +59,8 @@ class ImageDecoder {
   TaskRunners runners_;
   std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
   fml::WeakPtr<IOManager> io_manager_;
+  // Orders the decodes posted to |concurrent_task_runner_|.
+  std::shared_ptr<ImageDecodeQueue> decode_queue_;
 
   ImageDecoder(
       const TaskRunners& runners,
@@ -8,11 +8,14 @@
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/impeller/core/allocator.h"
 #include "flutter/impeller/display_list/dl_image_impeller.h"
 #include "flutter/impeller/renderer/command_buffer.h"
 #include "flutter/impeller/renderer/context.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+#include "flutter/lib/ui/painting/decoded_image_disk_cache.h"
 #include "impeller/base/strings.h"
 #include "impeller/core/device_buffer.h"
 #include "impeller/core/formats.h"
@@ -81,9 +84,11 @@ ImageDecoderImpeller::ImageDecoderImpeller(
     std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
     const fml::WeakPtr<IOManager>& io_manager,
     bool supports_wide_gamut,
-    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch)
+    const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+    bool enable_disk_cache)
     : ImageDecoder(runners, std::move(concurrent_task_runner), io_manager),
       supports_wide_gamut_(supports_wide_gamut),
+      enable_disk_cache_(enable_disk_cache),
       gpu_disabled_switch_(gpu_disabled_switch) {
   std::promise<std::shared_ptr<impeller::Context>> context_promise;
   context_ = context_promise.get_future();
@@ -106,7 +111,9 @@ static SkColorType ChooseCompatibleColorType(SkColorType type) {
 }
 
 static SkAlphaType ChooseCompatibleAlphaType(SkAlphaType type) {
-  return type;
+  // Impeller samples premultiplied textures. Unpremultiplied pixels are
+  // premultiplied while they are decoded or converted.
+  return type == kUnpremul_SkAlphaType ? kPremul_SkAlphaType : type;
 }
 
 DecompressResult ImageDecoderImpeller::DecompressTexture(
@@ -184,7 +191,17 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       return DecompressResult{.decode_error = decode_error};
     }
     // Decode the image into the image generator's closest supported size.
-    if (!descriptor->get_pixels(bitmap->pixmap())) {
+    bool decoded = descriptor->get_pixels(bitmap->pixmap());
+    if (!decoded && alpha_type != base_image_info.alphaType()) {
+      // The generator can't premultiply while decoding. Decode into an
+      // intermediate and premultiply while copying into the upload buffer.
+      SkBitmap unpremul_bitmap;
+      decoded = unpremul_bitmap.tryAllocPixels(
+                    image_info.makeAlphaType(base_image_info.alphaType())) &&
+                descriptor->get_pixels(unpremul_bitmap.pixmap()) &&
+                unpremul_bitmap.readPixels(bitmap->pixmap());
+    }
+    if (!decoded) {
       std::string decode_error("Could not decompress image.");
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
@@ -202,29 +219,13 @@ DecompressResult ImageDecoderImpeller::DecompressTexture(
       FML_DLOG(ERROR) << decode_error;
       return DecompressResult{.decode_error = decode_error};
     }
+    // Swizzling, premultiplication, the color space transform and the
+    // conversion to half floats all happen in a single vectorized pass that
+    // writes straight into the upload buffer.
     temp_bitmap->readPixels(bitmap->pixmap());
     bitmap->setImmutable();
   }
 
-  // If the image is unpremultiplied, fix it.
-  if (alpha_type == SkAlphaType::kUnpremul_SkAlphaType) {
-    // Single copy of ImpellerAllocator crashes.
-    auto premul_allocator = std::make_shared<ImpellerAllocator>(allocator);
-    auto premul_bitmap = std::make_shared<SkBitmap>();
-    premul_bitmap->setInfo(bitmap->info().makeAlphaType(kPremul_SkAlphaType));
-    if (!premul_bitmap->tryAllocPixels(premul_allocator.get())) {
-      std::string decode_error(
-          "Could not allocate intermediate for premultiplication conversion.");
-      FML_DLOG(ERROR) << decode_error;
-      return DecompressResult{.decode_error = decode_error};
-    }
-    // readPixels() handles converting pixels to premultiplied form.
-    bitmap->readPixels(premul_bitmap->pixmap());
-    premul_bitmap->setImmutable();
-    bitmap_allocator = premul_allocator;
-    bitmap = premul_bitmap;
-  }
-
   std::shared_ptr<impeller::DeviceBuffer> buffer =
       bitmap_allocator->GetDeviceBuffer();
   if (!buffer) {
@@ -302,10 +303,10 @@ ImageDecoderImpeller::UnsafeUploadTextureToPrivate(
   texture_descriptor.size = {image_info.width(), image_info.height()};
   texture_descriptor.mip_count = texture_descriptor.size.MipCount();
   texture_descriptor.compression_type = impeller::CompressionType::kLossy;
-  if (context->GetBackendType() == impeller::Context::BackendType::kMetal &&
-      resize_info.has_value()) {
-    // The MPS used to resize images on iOS does not require mip generation.
-    // Remove mip count if we are resizing the image on the GPU.
+  if (resize_info.has_value()) {
+    // When resizing on the GPU, this texture is only read by the resize blit
+    // (or the MPS on iOS), which samples the base level. The resized texture
+    // gets its own mipmaps, so don't allocate or generate them here.
     texture_descriptor.mip_count = 1;
   }
 
@@ -488,11 +489,61 @@ ImageDecoderImpeller::UploadTextureToStorage(
                         std::string());
 }
 
+// Copies the pixels of an image decoded by a previous launch from the disk
+// cache into a host visible buffer for upload.
+static DecompressResult LoadFromDiskCache(
+    const DecodedImageDiskCache::Key& key,
+    SkISize target_size,
+    impeller::ISize max_texture_size,
+    const std::shared_ptr<impeller::Allocator>& allocator) {
+  SkPixmap cached_pixmap;
+  auto mapping =
+      DecodedImageDiskCache::GetCacheForProcess()->Load(key, &cached_pixmap);
+  if (!mapping) {
+    return {};
+  }
+  if (cached_pixmap.width() > max_texture_size.width ||
+      cached_pixmap.height() > max_texture_size.height) {
+    return {};
+  }
+
+  auto bitmap = std::make_shared<SkBitmap>();
+  bitmap->setInfo(cached_pixmap.info());
+  auto bitmap_allocator = std::make_shared<ImpellerAllocator>(allocator);
+  if (!bitmap->tryAllocPixels(bitmap_allocator.get()) ||
+      !cached_pixmap.readPixels(bitmap->pixmap())) {
+    return {};
+  }
+  bitmap->setImmutable();
+
+  std::shared_ptr<impeller::DeviceBuffer> buffer =
+      bitmap_allocator->GetDeviceBuffer();
+  if (!buffer) {
+    return {};
+  }
+  buffer->Flush();
+
+  target_size.set(std::min(static_cast<int32_t>(max_texture_size.width),
+                           target_size.width()),
+                  std::min(static_cast<int32_t>(max_texture_size.height),
+                           target_size.height()));
+  std::optional<SkImageInfo> resize_info =
+      bitmap->dimensions() == target_size
+          ? std::nullopt
+          : std::optional<SkImageInfo>(
+                bitmap->info().makeDimensions(target_size));
+  return DecompressResult{.device_buffer = std::move(buffer),
+                          .sk_bitmap = bitmap,
+                          .image_info = bitmap->info(),
+                          .resize_info = resize_info};
+}
+
 // |ImageDecoder|
 void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
                                   uint32_t target_width,
                                   uint32_t target_height,
-                                  const ImageResult& p_result) {
+                                  const ImageResult& p_result,
+                                  const Options& options) {
   FML_DCHECK(descriptor);
   FML_DCHECK(p_result);
 
@@ -509,25 +560,74 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
     });
   };
 
-  concurrent_task_runner_->PostTask(
+  decode_queue_->Push(
+      options.priority, options.cancelled,
       [raw_descriptor,                                            //
        context = context_.get(),                                  //
        target_size = SkISize::Make(target_width, target_height),  //
        io_runner = runners_.GetIOTaskRunner(),                    //
-       result,
+       raw_result = result,
        supports_wide_gamut = supports_wide_gamut_,  //
+       enable_disk_cache = enable_disk_cache_,      //
        gpu_disabled_switch = gpu_disabled_switch_]() {
         if (!context) {
-          result(nullptr, "No Impeller context is available");
+          raw_result(nullptr, "No Impeller context is available");
           return;
         }
+
+        // Identical compressed images requested at the same size share a
+        // single decode and texture.
+        ImageResult result = raw_result;
+        if (raw_descriptor->is_compressed() && raw_descriptor->data()) {
+          auto* cache = DecodedImageCache::GetCacheForProcess();
+          auto key = DecodedImageCache::MakeKey(
+              *raw_descriptor->data(), target_size, supports_wide_gamut,
+              context.get());
+          switch (cache->Lookup(key, raw_descriptor->data(), context,
+                                raw_result)) {
+            case DecodedImageCache::LookupResult::kHit:
+            case DecodedImageCache::LookupResult::kCoalesced:
+              return;
+            case DecodedImageCache::LookupResult::kMiss:
+              result = [cache, key, raw_result](sk_sp<DlImage> image,
+                                                std::string decode_error) {
+                cache->Complete(key, image, decode_error);
+                raw_result(std::move(image), std::move(decode_error));
+              };
+              break;
+            case DecodedImageCache::LookupResult::kUncached:
+              break;
+          }
+        }
+
         auto max_size_supported =
             context->GetResourceAllocator()->GetMaxTextureSizeSupported();
 
-        // Always decompress on the concurrent runner.
-        auto bitmap_result = DecompressTexture(
-            raw_descriptor, target_size, max_size_supported,
-            supports_wide_gamut, context->GetResourceAllocator());
+        // Images decoded by a previous launch skip the codec.
+        std::optional<DecodedImageDiskCache::Key> disk_cache_key;
+        DecompressResult bitmap_result;
+        if (enable_disk_cache && raw_descriptor->is_compressed() &&
+            raw_descriptor->data()) {
+          disk_cache_key = DecodedImageDiskCache::MakeKey(
+              *raw_descriptor->data(), target_size, supports_wide_gamut);
+          bitmap_result =
+              LoadFromDiskCache(*disk_cache_key, target_size,
+                                max_size_supported,
+                                context->GetResourceAllocator());
+        }
+
+        bool store_in_disk_cache = false;
+        if (!bitmap_result.device_buffer) {
+          // Always decompress on the concurrent runner.
+          const auto decode_start = fml::TimePoint::Now();
+          bitmap_result = DecompressTexture(
+              raw_descriptor, target_size, max_size_supported,
+              supports_wide_gamut, context->GetResourceAllocator());
+          store_in_disk_cache =
+              disk_cache_key.has_value() &&
+              fml::TimePoint::Now() - decode_start >=
+                  DecodedImageDiskCache::kMinDecodeDuration;
+        }
         if (!bitmap_result.device_buffer) {
           result(nullptr, bitmap_result.decode_error);
           return;
@@ -550,7 +650,15 @@ void ImageDecoderImpeller::Decode(fml::RefPtr<ImageDescriptor> descriptor,
         } else {
           upload_texture_and_invoke_result();
         }
-      });
+
+        // Written after the upload is started so that the disk I/O does not
+        // delay the image.
+        if (store_in_disk_cache) {
+          DecodedImageDiskCache::GetCacheForProcess()->Store(
+              *disk_cache_key, bitmap_result.sk_bitmap->pixmap());
+        }
+      },
+      [result]() { result(nullptr, "Image decode was cancelled"); });
 }
 
 ImpellerAllocator::ImpellerAllocator(
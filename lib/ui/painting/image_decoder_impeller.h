@@ -53,7 +53,8 @@ class ImageDecoderImpeller final : public ImageDecoder {
       std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner,
       const fml::WeakPtr<IOManager>& io_manager,
       bool supports_wide_gamut,
-      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch);
+      const std::shared_ptr<fml::SyncSwitch>& gpu_disabled_switch,
+      bool enable_disk_cache = false);
 
   ~ImageDecoderImpeller() override;
 
@@ -61,7 +62,8 @@ class ImageDecoderImpeller final : public ImageDecoder {
   void Decode(fml::RefPtr<ImageDescriptor> descriptor,
               uint32_t target_width,
               uint32_t target_height,
-              const ImageResult& result) override;
+              const ImageResult& result,
+              const Options& options) override;
 
   static DecompressResult DecompressTexture(
       ImageDescriptor* descriptor,
@@ -100,6 +102,8 @@ class ImageDecoderImpeller final : public ImageDecoder {
   using FutureContext = std::shared_future<std::shared_ptr<impeller::Context>>;
   FutureContext context_;
   const bool supports_wide_gamut_;
+  // Whether expensive decodes are persisted in the |DecodedImageDiskCache|.
+  const bool enable_disk_cache_;
   std::shared_ptr<fml::SyncSwitch> gpu_disabled_switch_;
 
   /// Only call this method if the GPU is available.
@@ -223,5 +223,38 @@ TEST(ImageDecoderNoGLTest, ImepllerUnmultipliedAlphaPng) {
 #endif  // IMPELLER_SUPPORTS_RENDERING
 }
 
+TEST(ImageDecoderNoGLTest, ImpellerRawUnmultipliedBGRAPixels) {
+  const uint32_t unpremul_pixels[] = {
+      // B, G, R, A in memory.
+      0x80FF8040,
+      0xFFFF8040,
+  };
+  auto data = SkData::MakeWithCopy(unpremul_pixels, sizeof(unpremul_pixels));
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      std::move(data),
+      SkImageInfo::Make(2, 1, kBGRA_8888_SkColorType, kUnpremul_SkAlphaType),
+      2 * 4);
+
+#if IMPELLER_SUPPORTS_RENDERING
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+  std::optional<DecompressResult> result =
+      ImageDecoderImpeller::DecompressTexture(
+          descriptor.get(), SkISize::Make(2, 1), {2, 1},
+          /*supports_wide_gamut=*/false, allocator);
+  ASSERT_TRUE(result->device_buffer);
+  ASSERT_EQ(result->image_info.colorType(), kRGBA_8888_SkColorType);
+  ASSERT_EQ(result->image_info.alphaType(), kPremul_SkAlphaType);
+
+  // The pixels are swizzled and premultiplied straight into the upload buffer.
+  const uint32_t* pixel_ptr =
+      reinterpret_cast<const uint32_t*>(result->device_buffer->OnGetContents());
+  ASSERT_EQ(pixel_ptr, result->sk_bitmap->getAddr32(0, 0));
+  // R, G, B, A in memory.
+  EXPECT_EQ(pixel_ptr[0], (uint32_t)0x80204080);
+  EXPECT_EQ(pixel_ptr[1], (uint32_t)0xFF4080FF);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
 }  // namespace testing
 }  // namespace flutter
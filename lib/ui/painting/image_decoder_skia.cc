@@ -222,7 +222,8 @@ static SkiaGPUObject<SkImage> UploadRasterImage(
 void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
                               uint32_t target_width,
                               uint32_t target_height,
-                              const ImageResult& callback) {
+                              const ImageResult& callback,
+                              const Options& options) {
   TRACE_EVENT0("flutter", __FUNCTION__);
   fml::tracing::TraceFlow flow(__FUNCTION__);
 
@@ -266,7 +267,8 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
     return;
   }
 
-  concurrent_task_runner_->PostTask(
+  decode_queue_->Push(
+      options.priority, options.cancelled,
       fml::MakeCopyable([raw_descriptor,                          //
                          io_manager = io_manager_,                //
                          io_runner = runners_.GetIOTaskRunner(),  //
@@ -327,7 +329,10 @@ void ImageDecoderSkia::Decode(fml::RefPtr<ImageDescriptor> descriptor_ref_ptr,
           // Finally, all done.
           result(std::move(uploaded), std::move(flow));
         }));
-      }));
+      }),
+      [result]() {
+        result({}, fml::tracing::TraceFlow("ImageDecoderSkia::Cancelled"));
+      });
 }
 
 }  // namespace flutter
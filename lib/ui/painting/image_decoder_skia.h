@@ -25,7 +25,8 @@ class ImageDecoderSkia final : public ImageDecoder {
   void Decode(fml::RefPtr<ImageDescriptor> descriptor,
               uint32_t target_width,
               uint32_t target_height,
-              const ImageResult& result) override;
+              const ImageResult& result,
+              const Options& options) override;
 
   static sk_sp<SkImage> ImageFromCompressedData(
       ImageDescriptor* descriptor,
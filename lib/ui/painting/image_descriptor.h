@@ -60,7 +60,13 @@ class ImageDescriptor : public RefCountedDartWrappable<ImageDescriptor> {
                       PixelFormat pixel_format);
 
   /// @brief  Associates a flutter::Codec object with the dart.ui Codec handle.
-  void instantiateCodec(Dart_Handle codec, int target_width, int target_height);
+  ///
+  /// @param  priority  The `ImageDecodePriority` index of the decode of a
+  ///                   single frame image.
+  void instantiateCodec(Dart_Handle codec,
+                        int target_width,
+                        int target_height,
+                        int priority);
 
   /// @brief  The width of this image, EXIF oriented if applicable.
   int width() const { return image_info_.width(); }
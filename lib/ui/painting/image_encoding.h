@@ -20,6 +20,7 @@ enum ImageByteFormat {
   kRawUnmodified,
   kRawExtendedRgba128,
   kPNG,
+  kQOI,
 };
 
 Dart_Handle EncodeImage(CanvasImage* canvas_image,
@@ -4,6 +4,9 @@
 
 #include "png.h"
 
+#include <algorithm>
+#include <set>
+
 #include "flutter/lib/ui/painting/image_encoding.h"
 #include "flutter/lib/ui/painting/image_encoding_impl.h"
 
@@ -16,6 +19,8 @@
 #include "flutter/testing/testing.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/painting/image_encoding_impeller.h"
@@ -576,6 +581,120 @@ TEST(ImageEncodingImpellerTest, PngEncodingBGRA10XR) {
 
 #endif  // IMPELLER_SUPPORTS_RENDERING
 
+namespace {
+
+struct DecodedQOI {
+  std::vector<uint8_t> pixels;
+  // The tags of the ops that the image was encoded with.
+  std::set<uint8_t> ops;
+};
+
+// Decodes QOI images with the ops of the reference implementation.
+DecodedQOI DecodeQOI(const SkData& data, size_t pixel_count) {
+  const uint8_t* bytes = data.bytes();
+  size_t offset = 14;  // The header.
+  uint8_t index[64][4] = {};
+  uint8_t pixel[4] = {0, 0, 0, 255};
+  DecodedQOI decoded;
+  while (decoded.pixels.size() < pixel_count * 4) {
+    const uint8_t op = bytes[offset++];
+    if (op == 0xfe || op == 0xff) {
+      decoded.ops.insert(op);
+      pixel[0] = bytes[offset++];
+      pixel[1] = bytes[offset++];
+      pixel[2] = bytes[offset++];
+      if (op == 0xff) {
+        pixel[3] = bytes[offset++];
+      }
+    } else {
+      decoded.ops.insert(op & 0xc0);
+      switch (op & 0xc0) {
+        case 0x00:
+          std::copy_n(index[op], 4, pixel);
+          break;
+        case 0x40:
+          pixel[0] = static_cast<uint8_t>(pixel[0] + ((op >> 4) & 0x03) - 2);
+          pixel[1] = static_cast<uint8_t>(pixel[1] + ((op >> 2) & 0x03) - 2);
+          pixel[2] = static_cast<uint8_t>(pixel[2] + (op & 0x03) - 2);
+          break;
+        case 0x80: {
+          const int dg = (op & 0x3f) - 32;
+          const uint8_t drdb = bytes[offset++];
+          pixel[0] = static_cast<uint8_t>(pixel[0] + dg + (drdb >> 4) - 8);
+          pixel[1] = static_cast<uint8_t>(pixel[1] + dg);
+          pixel[2] = static_cast<uint8_t>(pixel[2] + dg + (drdb & 0x0f) - 8);
+          break;
+        }
+        case 0xc0:
+          for (int i = 0; i < (op & 0x3f); i++) {
+            decoded.pixels.insert(decoded.pixels.end(), pixel, pixel + 4);
+          }
+          break;
+      }
+    }
+    std::copy_n(pixel, 4,
+                index[(pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 +
+                       pixel[3] * 11) %
+                      64]);
+    decoded.pixels.insert(decoded.pixels.end(), pixel, pixel + 4);
+  }
+  EXPECT_EQ(data.size(), offset + 8);  // The end marker.
+  return decoded;
+}
+
+}  // namespace
+
+TEST(ImageEncodingTest, QOIEncodingRoundTrips) {
+  // Straight alpha pixels that are encoded with each kind of op.
+  const std::vector<uint8_t> pixels = {
+      10,  20,  30, 255,  // RGB, too far from the initial black.
+      14,  26,  33, 255,  // LUMA.
+      15,  26,  33, 255,  // DIFF.
+      15,  26,  33, 128,  // RGBA, as the alpha changed.
+      15,  26,  33, 128,  // RUN.
+      10,  20,  30, 255,  // INDEX of the first pixel.
+      200, 100, 50, 255,  // RGB.
+      200, 100, 50, 255,  // RUN that ends the image.
+  };
+  const SkImageInfo info =
+      SkImageInfo::Make(4, 2, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+  sk_sp<SkImage> image = SkImages::RasterFromPixmapCopy(
+      SkPixmap(info, pixels.data(), info.minRowBytes()));
+  ASSERT_TRUE(image);
+
+  fml::StatusOr<sk_sp<SkData>> qoi = EncodeImage(image, ImageByteFormat::kQOI);
+  ASSERT_TRUE(qoi.ok());
+
+  DecodedQOI decoded = DecodeQOI(*qoi.value(), 8);
+  EXPECT_EQ(decoded.pixels, pixels);
+  EXPECT_EQ(decoded.ops,
+            (std::set<uint8_t>{0x00, 0x40, 0x80, 0xc0, 0xfe, 0xff}));
+}
+
+TEST(ImageEncodingTest, QOIEncodingOfSolidImage) {
+  auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(10, 10));
+  surface->getCanvas()->clear(SK_ColorWHITE);
+  sk_sp<SkImage> image = surface->makeImageSnapshot();
+
+  fml::StatusOr<sk_sp<SkData>> qoi = EncodeImage(image, ImageByteFormat::kQOI);
+  ASSERT_TRUE(qoi.ok());
+
+  const std::vector<uint8_t> expected = {
+      'q', 'o', 'i', 'f',  //
+      0, 0, 0, 10,         // Width.
+      0, 0, 0, 10,         // Height.
+      4, 0,                // Channels and colorspace.
+      0x55,                // The first pixel as a difference from black.
+      0xc0 | 61,           // A run of 62 pixels.
+      0xc0 | 36,           // The remaining 37 pixels.
+      0, 0, 0, 0, 0, 0, 0, 1,  // End marker.
+  };
+  ASSERT_EQ(qoi.value()->size(), expected.size());
+  EXPECT_EQ(std::vector<uint8_t>(qoi.value()->bytes(),
+                                 qoi.value()->bytes() + qoi.value()->size()),
+            expected);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -0,0 +1,549 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "flutter/fml/endianness.h"
+#include "flutter/fml/logging.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkSamplingOptions.h"
+
+namespace flutter {
+
+namespace {
+
+// The sizes of the fixed header, the section index and a single entry of the
+// level index. See the "File Structure" section of the KTX 2.0 specification.
+constexpr size_t kHeaderSize = 48;
+constexpr size_t kIndexSize = 32;
+constexpr size_t kLevelIndexEntrySize = 24;
+
+// Keeps the byte size computations well away from overflow. This is far
+// larger than the maximum texture size of any supported device.
+constexpr uint32_t kMaxDimension = 1u << 16;
+
+constexpr int kBlockDimension = 4;
+
+// The bit in the flags of the basic data format descriptor block that
+// indicates that color channels are premultiplied by alpha.
+constexpr uint8_t kDataFormatFlagAlphaPremultiplied = 1u;
+
+// ETC1 modifier tables. Each row holds the small and large modifier of a
+// table. Negative modifiers are selected by the high bit of a pixel index.
+constexpr int kETC1Modifiers[8][2] = {
+    {2, 8},   {5, 17},  {9, 29},  {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+// Distances between the paint colors of the ETC2 "T" and "H" modes.
+constexpr int kETC2Distances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+// EAC modifier tables used by the alpha blocks of ETC2 RGBA8.
+constexpr int kEACModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+template <typename T>
+T ReadLittleEndian(const uint8_t* bytes) {
+  T value;
+  memcpy(&value, bytes, sizeof(T));
+  return fml::LittleEndianToArch(value);
+}
+
+uint64_t ReadBlock(const uint8_t* bytes) {
+  uint64_t value;
+  memcpy(&value, bytes, sizeof(value));
+  return fml::BigEndianToArch(value);
+}
+
+uint32_t GetBits(uint64_t block, int offset, int count) {
+  return static_cast<uint32_t>((block >> offset) & ((1u << count) - 1u));
+}
+
+uint8_t ClampToByte(int value) {
+  return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+int Extend4(int value) {
+  return (value << 4) | value;
+}
+
+int Extend5(int value) {
+  return (value << 3) | (value >> 2);
+}
+
+int Extend6(int value) {
+  return (value << 2) | (value >> 4);
+}
+
+int Extend7(int value) {
+  return (value << 1) | (value >> 6);
+}
+
+// Decoded blocks are stored as 4x4 RGBA pixels in row major order.
+using DecodedBlock = uint8_t[kBlockDimension * kBlockDimension * 4];
+
+uint8_t* GetBlockPixel(DecodedBlock& pixels, int x, int y) {
+  return &pixels[(y * kBlockDimension + x) * 4];
+}
+
+// Pixel indices are stored in column major order. The high bits of all indices
+// precede the low bits.
+int GetPixelIndex(uint64_t block, int x, int y) {
+  const int bit = x * kBlockDimension + y;
+  return static_cast<int>((GetBits(block, bit + 16, 1) << 1) |
+                          GetBits(block, bit, 1));
+}
+
+void WritePaintColors(uint64_t block,
+                      const int (&paint)[4][3],
+                      DecodedBlock& pixels) {
+  for (int y = 0; y < kBlockDimension; y++) {
+    for (int x = 0; x < kBlockDimension; x++) {
+      const int* color = paint[GetPixelIndex(block, x, y)];
+      uint8_t* pixel = GetBlockPixel(pixels, x, y);
+      pixel[0] = ClampToByte(color[0]);
+      pixel[1] = ClampToByte(color[1]);
+      pixel[2] = ClampToByte(color[2]);
+    }
+  }
+}
+
+void DecodeTModeBlock(uint64_t block, DecodedBlock& pixels) {
+  const int c1[3] = {
+      Extend4((GetBits(block, 59, 2) << 2) | GetBits(block, 56, 2)),
+      Extend4(GetBits(block, 52, 4)),
+      Extend4(GetBits(block, 48, 4)),
+  };
+  const int c2[3] = {
+      Extend4(GetBits(block, 44, 4)),
+      Extend4(GetBits(block, 40, 4)),
+      Extend4(GetBits(block, 36, 4)),
+  };
+  const int d =
+      kETC2Distances[(GetBits(block, 34, 2) << 1) | GetBits(block, 32, 1)];
+  const int paint[4][3] = {
+      {c1[0], c1[1], c1[2]},
+      {c2[0] + d, c2[1] + d, c2[2] + d},
+      {c2[0], c2[1], c2[2]},
+      {c2[0] - d, c2[1] - d, c2[2] - d},
+  };
+  WritePaintColors(block, paint, pixels);
+}
+
+void DecodeHModeBlock(uint64_t block, DecodedBlock& pixels) {
+  const int c1[3] = {
+      Extend4(GetBits(block, 59, 4)),
+      Extend4((GetBits(block, 56, 3) << 1) | GetBits(block, 52, 1)),
+      Extend4((GetBits(block, 51, 1) << 3) | GetBits(block, 47, 3)),
+  };
+  const int c2[3] = {
+      Extend4(GetBits(block, 43, 4)),
+      Extend4(GetBits(block, 39, 4)),
+      Extend4(GetBits(block, 35, 4)),
+  };
+  // The lowest bit of the distance index is implied by the order of the base
+  // colors.
+  const int v1 = (c1[0] << 16) | (c1[1] << 8) | c1[2];
+  const int v2 = (c2[0] << 16) | (c2[1] << 8) | c2[2];
+  const int d = kETC2Distances[(GetBits(block, 34, 1) << 2) |
+                               (GetBits(block, 32, 1) << 1) |
+                               (v1 >= v2 ? 1 : 0)];
+  const int paint[4][3] = {
+      {c1[0] + d, c1[1] + d, c1[2] + d},
+      {c1[0] - d, c1[1] - d, c1[2] - d},
+      {c2[0] + d, c2[1] + d, c2[2] + d},
+      {c2[0] - d, c2[1] - d, c2[2] - d},
+  };
+  WritePaintColors(block, paint, pixels);
+}
+
+void DecodePlanarBlock(uint64_t block, DecodedBlock& pixels) {
+  const int origin[3] = {
+      Extend6(GetBits(block, 57, 6)),
+      Extend7((GetBits(block, 56, 1) << 6) | GetBits(block, 49, 6)),
+      Extend6((GetBits(block, 48, 1) << 5) | (GetBits(block, 43, 2) << 3) |
+              GetBits(block, 39, 3)),
+  };
+  const int horizontal[3] = {
+      Extend6((GetBits(block, 34, 5) << 1) | GetBits(block, 32, 1)),
+      Extend7(GetBits(block, 25, 7)),
+      Extend6(GetBits(block, 19, 6)),
+  };
+  const int vertical[3] = {
+      Extend6(GetBits(block, 13, 6)),
+      Extend7(GetBits(block, 6, 7)),
+      Extend6(GetBits(block, 0, 6)),
+  };
+  for (int y = 0; y < kBlockDimension; y++) {
+    for (int x = 0; x < kBlockDimension; x++) {
+      uint8_t* pixel = GetBlockPixel(pixels, x, y);
+      for (int c = 0; c < 3; c++) {
+        pixel[c] = ClampToByte((x * (horizontal[c] - origin[c]) +
+                                y * (vertical[c] - origin[c]) +
+                                4 * origin[c] + 2) >>
+                               2);
+      }
+    }
+  }
+}
+
+int SignExtend3(uint32_t value) {
+  return static_cast<int>(value << 29) >> 29;
+}
+
+// Decodes the color channels of an ETC2 RGB8 block. Alpha is left untouched.
+void DecodeETC2ColorBlock(uint64_t block, DecodedBlock& pixels) {
+  int base[2][3];
+  if (GetBits(block, 33, 1)) {
+    // Differential mode. A second base color outside of the representable
+    // range selects one of the modes added by ETC2.
+    int c1[3];
+    int c2[3];
+    for (int c = 0; c < 3; c++) {
+      const int offset = 59 - c * 8;
+      c1[c] = GetBits(block, offset, 5);
+      c2[c] = c1[c] + SignExtend3(GetBits(block, offset - 3, 3));
+    }
+    if (c2[0] < 0 || c2[0] > 31) {
+      DecodeTModeBlock(block, pixels);
+      return;
+    }
+    if (c2[1] < 0 || c2[1] > 31) {
+      DecodeHModeBlock(block, pixels);
+      return;
+    }
+    if (c2[2] < 0 || c2[2] > 31) {
+      DecodePlanarBlock(block, pixels);
+      return;
+    }
+    for (int c = 0; c < 3; c++) {
+      base[0][c] = Extend5(c1[c]);
+      base[1][c] = Extend5(c2[c]);
+    }
+  } else {
+    // Individual mode.
+    for (int c = 0; c < 3; c++) {
+      const int offset = 60 - c * 8;
+      base[0][c] = Extend4(GetBits(block, offset, 4));
+      base[1][c] = Extend4(GetBits(block, offset - 4, 4));
+    }
+  }
+
+  const uint32_t tables[2] = {GetBits(block, 37, 3), GetBits(block, 34, 3)};
+  const bool flip = GetBits(block, 32, 1);
+  for (int y = 0; y < kBlockDimension; y++) {
+    for (int x = 0; x < kBlockDimension; x++) {
+      // Without the flip bit the block is split into two 2x4 sub-blocks side
+      // by side, otherwise into two 4x2 sub-blocks on top of each other.
+      const int sub_block = flip ? (y >= 2) : (x >= 2);
+      const int index = GetPixelIndex(block, x, y);
+      int modifier = kETC1Modifiers[tables[sub_block]][index & 1];
+      if (index & 2) {
+        modifier = -modifier;
+      }
+      uint8_t* pixel = GetBlockPixel(pixels, x, y);
+      for (int c = 0; c < 3; c++) {
+        pixel[c] = ClampToByte(base[sub_block][c] + modifier);
+      }
+    }
+  }
+}
+
+void DecodeEACAlphaBlock(uint64_t block, DecodedBlock& pixels) {
+  const int base = GetBits(block, 56, 8);
+  const int multiplier = GetBits(block, 52, 4);
+  const int* modifiers = kEACModifiers[GetBits(block, 48, 4)];
+  for (int x = 0; x < kBlockDimension; x++) {
+    for (int y = 0; y < kBlockDimension; y++) {
+      const int bit = 45 - 3 * (x * kBlockDimension + y);
+      GetBlockPixel(pixels, x, y)[3] =
+          ClampToByte(base + modifiers[GetBits(block, bit, 3)] * multiplier);
+    }
+  }
+}
+
+}  // namespace
+
+KTX2ImageGenerator::~KTX2ImageGenerator() = default;
+
+KTX2ImageGenerator::KTX2ImageGenerator(sk_sp<SkData> data,
+                                       Format format,
+                                       std::vector<Level> levels,
+                                       bool premultiplied)
+    : data_(std::move(data)),
+      format_(format),
+      levels_(std::move(levels)),
+      premultiplied_(premultiplied) {
+  // Prefer premul over unpremul (this produces better filtering in general)
+  image_info_ = SkImageInfo::Make(
+      levels_.front().size, kRGBA_8888_SkColorType,
+      HasAlpha(format_) ? kPremul_SkAlphaType : kOpaque_SkAlphaType,
+      SkColorSpace::MakeSRGB());
+}
+
+const SkImageInfo& KTX2ImageGenerator::GetInfo() {
+  return image_info_;
+}
+
+unsigned int KTX2ImageGenerator::GetFrameCount() const {
+  return 1;
+}
+
+unsigned int KTX2ImageGenerator::GetPlayCount() const {
+  return 1;
+}
+
+const ImageGenerator::FrameInfo KTX2ImageGenerator::GetFrameInfo(
+    unsigned int frame_index) {
+  return {.required_frame = std::nullopt,
+          .duration = 0,
+          .disposal_method = SkCodecAnimation::DisposalMethod::kKeep};
+}
+
+SkISize KTX2ImageGenerator::GetScaledDimensions(float desired_scale) {
+  const SkISize base_size = levels_.front().size;
+  const float desired_width = std::ceil(base_size.width() * desired_scale);
+  const float desired_height = std::ceil(base_size.height() * desired_scale);
+  SkISize size = base_size;
+  for (const auto& level : levels_) {
+    if (level.size.width() < desired_width ||
+        level.size.height() < desired_height) {
+      break;
+    }
+    size = level.size;
+  }
+  return size;
+}
+
+bool KTX2ImageGenerator::GetPixels(const SkImageInfo& info,
+                                   void* pixels,
+                                   size_t row_bytes,
+                                   unsigned int frame_index,
+                                   std::optional<unsigned int> prior_frame) {
+  // Decode the mip level matching the requested size. Sizes reported by
+  // |GetScaledDimensions| always match a level, other sizes are resampled from
+  // the base level.
+  const Level* level = &levels_.front();
+  for (const auto& candidate : levels_) {
+    if (candidate.size == info.dimensions()) {
+      level = &candidate;
+      break;
+    }
+  }
+
+  SkAlphaType alpha_type = kOpaque_SkAlphaType;
+  if (HasAlpha(format_)) {
+    alpha_type = premultiplied_ ? kPremul_SkAlphaType : kUnpremul_SkAlphaType;
+  }
+  SkPixmap level_pixmap;
+  SkBitmap level_bitmap;
+  if (IsBlockCompressed(format_)) {
+    const SkImageInfo level_info =
+        SkImageInfo::Make(level->size, kRGBA_8888_SkColorType, alpha_type,
+                          SkColorSpace::MakeSRGB());
+    if (!level_bitmap.tryAllocPixels(level_info)) {
+      FML_DLOG(ERROR) << "Failed to allocate memory for bitmap of size "
+                      << level_info.computeMinByteSize() << "B";
+      return false;
+    }
+    DecodeCompressedLevel(*level, level_bitmap.pixmap());
+    level_pixmap = level_bitmap.pixmap();
+  } else {
+    const SkColorType color_type = (format_ == Format::kB8G8R8A8UNorm ||
+                                    format_ == Format::kB8G8R8A8SRGB)
+                                       ? kBGRA_8888_SkColorType
+                                       : kRGBA_8888_SkColorType;
+    const SkImageInfo level_info = SkImageInfo::Make(
+        level->size, color_type, alpha_type, SkColorSpace::MakeSRGB());
+    level_pixmap.reset(level_info, data_->bytes() + level->offset,
+                       level_info.minRowBytes());
+  }
+
+  SkPixmap output_pixmap(info, pixels, row_bytes);
+  if (level->size == info.dimensions()) {
+    return level_pixmap.readPixels(output_pixmap);
+  }
+  return level_pixmap.scalePixels(
+      output_pixmap,
+      SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kNone));
+}
+
+void KTX2ImageGenerator::DecodeCompressedLevel(const Level& level,
+                                               const SkPixmap& pixmap) const {
+  const bool has_alpha = HasAlpha(format_);
+  const int blocks_wide =
+      (level.size.width() + kBlockDimension - 1) / kBlockDimension;
+  const int blocks_high =
+      (level.size.height() + kBlockDimension - 1) / kBlockDimension;
+  const uint8_t* block_data = data_->bytes() + level.offset;
+
+  DecodedBlock block_pixels;
+  memset(block_pixels, 0xFF, sizeof(block_pixels));
+  for (int block_y = 0; block_y < blocks_high; block_y++) {
+    for (int block_x = 0; block_x < blocks_wide; block_x++) {
+      // ETC2 RGBA8 blocks store the alpha block before the color block.
+      if (has_alpha) {
+        DecodeEACAlphaBlock(ReadBlock(block_data), block_pixels);
+        block_data += 8;
+      }
+      DecodeETC2ColorBlock(ReadBlock(block_data), block_pixels);
+      block_data += 8;
+
+      // Blocks on the right and bottom edges may extend past the level.
+      const int x = block_x * kBlockDimension;
+      const int y = block_y * kBlockDimension;
+      const int width = std::min(kBlockDimension, level.size.width() - x);
+      const int height = std::min(kBlockDimension, level.size.height() - y);
+      for (int row = 0; row < height; row++) {
+        memcpy(pixmap.writable_addr(x, y + row),
+               GetBlockPixel(block_pixels, 0, row), width * 4);
+      }
+    }
+  }
+}
+
+bool KTX2ImageGenerator::IsSupportedFormat(uint32_t vk_format) {
+  switch (static_cast<Format>(vk_format)) {
+    case Format::kR8G8B8A8UNorm:
+    case Format::kR8G8B8A8SRGB:
+    case Format::kB8G8R8A8UNorm:
+    case Format::kB8G8R8A8SRGB:
+    case Format::kETC2R8G8B8UNormBlock:
+    case Format::kETC2R8G8B8SRGBBlock:
+    case Format::kETC2R8G8B8A8UNormBlock:
+    case Format::kETC2R8G8B8A8SRGBBlock:
+      return true;
+  }
+  return false;
+}
+
+bool KTX2ImageGenerator::IsBlockCompressed(Format format) {
+  switch (format) {
+    case Format::kETC2R8G8B8UNormBlock:
+    case Format::kETC2R8G8B8SRGBBlock:
+    case Format::kETC2R8G8B8A8UNormBlock:
+    case Format::kETC2R8G8B8A8SRGBBlock:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool KTX2ImageGenerator::HasAlpha(Format format) {
+  switch (format) {
+    case Format::kETC2R8G8B8UNormBlock:
+    case Format::kETC2R8G8B8SRGBBlock:
+      return false;
+    default:
+      return true;
+  }
+}
+
+size_t KTX2ImageGenerator::GetLevelByteSize(Format format, SkISize size) {
+  if (!IsBlockCompressed(format)) {
+    return static_cast<size_t>(size.width()) * size.height() * 4u;
+  }
+  const size_t blocks_wide =
+      (size.width() + kBlockDimension - 1) / kBlockDimension;
+  const size_t blocks_high =
+      (size.height() + kBlockDimension - 1) / kBlockDimension;
+  return blocks_wide * blocks_high * (HasAlpha(format) ? 16u : 8u);
+}
+
+std::unique_ptr<ImageGenerator> KTX2ImageGenerator::MakeFromData(
+    sk_sp<SkData> data) {
+  if (!data || data->size() < kHeaderSize + kIndexSize) {
+    return nullptr;
+  }
+  const uint8_t* bytes = data->bytes();
+  if (memcmp(bytes, kKTX2Identifier, sizeof(kKTX2Identifier))) {
+    return nullptr;
+  }
+
+  const uint8_t* header = bytes + sizeof(kKTX2Identifier);
+  const auto vk_format = ReadLittleEndian<uint32_t>(header);
+  const auto pixel_width = ReadLittleEndian<uint32_t>(header + 8);
+  const auto pixel_height = ReadLittleEndian<uint32_t>(header + 12);
+  const auto pixel_depth = ReadLittleEndian<uint32_t>(header + 16);
+  const auto layer_count = ReadLittleEndian<uint32_t>(header + 20);
+  const auto face_count = ReadLittleEndian<uint32_t>(header + 24);
+  const auto level_count =
+      std::max(ReadLittleEndian<uint32_t>(header + 28), 1u);
+  const auto supercompression_scheme = ReadLittleEndian<uint32_t>(header + 32);
+
+  if (!IsSupportedFormat(vk_format)) {
+    FML_DLOG(WARNING) << "Unsupported KTX2 format (VkFormat=" << vk_format
+                      << ").";
+    return nullptr;
+  }
+  if (supercompression_scheme != 0u || pixel_depth != 0u ||
+      layer_count > 1u || face_count != 1u) {
+    FML_DLOG(WARNING) << "Only single 2D KTX2 textures without "
+                         "supercompression are supported.";
+    return nullptr;
+  }
+  if (pixel_width == 0u || pixel_height == 0u ||
+      pixel_width > kMaxDimension || pixel_height > kMaxDimension ||
+      level_count > 32u) {
+    return nullptr;
+  }
+  if (data->size() <
+      kHeaderSize + kIndexSize + level_count * kLevelIndexEntrySize) {
+    return nullptr;
+  }
+
+  // Straight alpha is the default. The basic data format descriptor block
+  // follows the total size of the descriptor, and its flags are the last byte
+  // of its third word.
+  bool premultiplied = false;
+  const uint8_t* index = bytes + kHeaderSize;
+  const auto dfd_offset = ReadLittleEndian<uint32_t>(index);
+  const auto dfd_length = ReadLittleEndian<uint32_t>(index + 4);
+  if (dfd_length >= 4u + 12u && dfd_offset <= data->size() &&
+      data->size() - dfd_offset >= dfd_length) {
+    premultiplied =
+        bytes[dfd_offset + 4u + 11u] & kDataFormatFlagAlphaPremultiplied;
+  }
+
+  const auto format = static_cast<Format>(vk_format);
+  std::vector<Level> levels;
+  levels.reserve(level_count);
+  const uint8_t* level_index = index + kIndexSize;
+  for (uint32_t i = 0; i < level_count; i++) {
+    const SkISize size =
+        SkISize::Make(std::max(pixel_width >> i, 1u),
+                      std::max(pixel_height >> i, 1u));
+    const auto offset = ReadLittleEndian<uint64_t>(level_index);
+    const auto length = ReadLittleEndian<uint64_t>(level_index + 8);
+    level_index += kLevelIndexEntrySize;
+
+    if (offset > data->size() || data->size() - offset < length ||
+        length < GetLevelByteSize(format, size)) {
+      FML_DLOG(WARNING) << "KTX2 level " << i << " is out of bounds.";
+      return nullptr;
+    }
+    levels.push_back({.size = size,
+                      .offset = static_cast<size_t>(offset),
+                      .length = static_cast<size_t>(length)});
+  }
+
+  return std::unique_ptr<ImageGenerator>(new KTX2ImageGenerator(
+      std::move(data), format, std::move(levels), premultiplied));
+}
+
+}  // namespace flutter
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+#define FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
+
+#include <vector>
+
+#include "image_generator.h"
+
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief  An image generator for KTX2 texture containers.
+///
+///         Textures are authored with a full mip chain, so scaled decodes pick
+///         the smallest mip level that covers the requested size instead of
+///         decoding the base level and resampling it.
+///
+///         Uncompressed RGBA/BGRA levels are converted directly. ETC2 RGB8 and
+///         RGBA8 levels are transcoded to RGBA on the CPU. Containers that use
+///         supercompression, cube maps, arrays, 3D textures or any other
+///         format are rejected so that the next registered generator is tried.
+class KTX2ImageGenerator : public ImageGenerator {
+ public:
+  ~KTX2ImageGenerator();
+
+  // |ImageGenerator|
+  const SkImageInfo& GetInfo() override;
+
+  // |ImageGenerator|
+  unsigned int GetFrameCount() const override;
+
+  // |ImageGenerator|
+  unsigned int GetPlayCount() const override;
+
+  // |ImageGenerator|
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override;
+
+  // |ImageGenerator|
+  SkISize GetScaledDimensions(float desired_scale) override;
+
+  // |ImageGenerator|
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override;
+
+  static std::unique_ptr<ImageGenerator> MakeFromData(sk_sp<SkData> data);
+
+ private:
+  static constexpr uint8_t kKTX2Identifier[12] = {
+      0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+  /// The subset of `VkFormat` values this generator can decode.
+  enum class Format {
+    kR8G8B8A8UNorm = 37,
+    kR8G8B8A8SRGB = 43,
+    kB8G8R8A8UNorm = 44,
+    kB8G8R8A8SRGB = 50,
+    kETC2R8G8B8UNormBlock = 147,
+    kETC2R8G8B8SRGBBlock = 148,
+    kETC2R8G8B8A8UNormBlock = 151,
+    kETC2R8G8B8A8SRGBBlock = 152,
+  };
+
+  struct Level {
+    SkISize size;
+    // Offset and length of the level data from the start of the container.
+    size_t offset;
+    size_t length;
+  };
+
+  KTX2ImageGenerator(sk_sp<SkData> data,
+                     Format format,
+                     std::vector<Level> levels,
+                     bool premultiplied);
+
+  /// @brief  Transcode a block compressed mip level into an RGBA8888 pixmap
+  ///         of the same size as the level.
+  void DecodeCompressedLevel(const Level& level, const SkPixmap& pixmap) const;
+
+  static bool IsSupportedFormat(uint32_t vk_format);
+
+  static bool IsBlockCompressed(Format format);
+
+  static bool HasAlpha(Format format);
+
+  static size_t GetLevelByteSize(Format format, SkISize size);
+
+  sk_sp<SkData> data_;
+  Format format_;
+  // Ordered from the base level to the smallest mip level.
+  std::vector<Level> levels_;
+  // Whether the color channels of the texture are premultiplied by alpha.
+  bool premultiplied_;
+  SkImageInfo image_info_;
+
+  FML_DISALLOW_COPY_ASSIGN_AND_MOVE(KTX2ImageGenerator);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_IMAGE_GENERATOR_KTX2_H_
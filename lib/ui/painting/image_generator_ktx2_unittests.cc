@@ -0,0 +1,264 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
+
+#include <array>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+// VkFormat values of the level formats.
+constexpr uint32_t kRGBA8 = 37;
+constexpr uint32_t kBGRA8 = 44;
+constexpr uint32_t kETC2RGB8 = 147;
+constexpr uint32_t kETC2RGBA8 = 151;
+
+using RGBA = std::array<uint8_t, 4>;
+
+// Builds a KTX2 texture with the given levels, ordered from the base level.
+// Straight alpha textures have no data format descriptor, since straight alpha
+// is the default.
+sk_sp<SkData> MakeKTX2Texture(uint32_t vk_format,
+                              SkISize size,
+                              const std::vector<std::vector<uint8_t>>& levels,
+                              bool premultiplied = false) {
+  std::vector<uint8_t> bytes = {
+      0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n',
+  };
+  auto append = [&bytes](uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+  };
+  // vkFormat, typeSize, pixelWidth, pixelHeight, pixelDepth, layerCount,
+  // faceCount, levelCount, supercompressionScheme.
+  for (uint32_t value :
+       {vk_format, 1u, static_cast<uint32_t>(size.width()),
+        static_cast<uint32_t>(size.height()), 0u, 0u, 1u,
+        static_cast<uint32_t>(levels.size()), 0u}) {
+    append(value, 4);
+  }
+
+  // The data format descriptor is its total size followed by a basic
+  // descriptor block, which follows the level index.
+  const size_t dfd_offset = 48 + 32 + levels.size() * 24;
+  const size_t dfd_length = premultiplied ? 4 + 24 : 0;
+  append(premultiplied ? dfd_offset : 0, 4);
+  append(dfd_length, 4);
+  // No key/value data or supercompression data.
+  append(0, 4);
+  append(0, 4);
+  append(0, 8);
+  append(0, 8);
+
+  size_t level_offset = dfd_offset + dfd_length;
+  for (const auto& level : levels) {
+    append(level_offset, 8);
+    append(level.size(), 8);
+    append(level.size(), 8);
+    level_offset += level.size();
+  }
+
+  if (premultiplied) {
+    append(dfd_length, 4);
+    std::vector<uint8_t> block(24, 0);
+    block[11] = 1;  // KHR_DF_FLAG_ALPHA_PREMULTIPLIED
+    bytes.insert(bytes.end(), block.begin(), block.end());
+  }
+  for (const auto& level : levels) {
+    bytes.insert(bytes.end(), level.begin(), level.end());
+  }
+  return SkData::MakeWithCopy(bytes.data(), bytes.size());
+}
+
+// Decodes the level of the given size. The output has the given alpha type,
+// so that straight alpha levels can be read back without conversion.
+SkBitmap DecodeLevel(const sk_sp<SkData>& texture,
+                     SkISize size,
+                     SkAlphaType alpha_type) {
+  SkBitmap bitmap;
+  auto generator = KTX2ImageGenerator::MakeFromData(texture);
+  if (!generator) {
+    return bitmap;
+  }
+  bitmap.allocPixels(
+      generator->GetInfo().makeDimensions(size).makeAlphaType(alpha_type));
+  if (!generator->GetPixels(bitmap.info(), bitmap.getPixels(),
+                            bitmap.rowBytes(), 0, std::nullopt)) {
+    bitmap.reset();
+  }
+  return bitmap;
+}
+
+// Decodes the 4x4 texture made of a single ETC2 RGB8 block.
+SkBitmap DecodeETC2Block(const std::vector<uint8_t>& block) {
+  return DecodeLevel(MakeKTX2Texture(kETC2RGB8, SkISize::Make(4, 4), {block}),
+                     SkISize::Make(4, 4), kOpaque_SkAlphaType);
+}
+
+RGBA GetPixel(const SkBitmap& bitmap, int x, int y) {
+  const auto* pixel = static_cast<const uint8_t*>(bitmap.getAddr(x, y));
+  return {pixel[0], pixel[1], pixel[2], pixel[3]};
+}
+
+// Individual mode. The left sub-block has the base color 0x88, 0x44, 0x22 and
+// the first modifier table, the right sub-block has the base color 0x11,
+// 0x22, 0x33 and the second modifier table. Pixel indices are the row number.
+const std::vector<uint8_t> kIndividualBlock = {0x81, 0x42, 0x23, 0x04,
+                                               0xCC, 0xCC, 0xAA, 0xAA};
+
+}  // namespace
+
+TEST(KTX2ImageGeneratorTest, DecodesETC2IndividualModeBlock) {
+  SkBitmap bitmap = DecodeETC2Block(kIndividualBlock);
+  ASSERT_FALSE(bitmap.isNull());
+
+  // Modifiers of the first table are +2, +8, -2 and -8.
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{138, 70, 36, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 1), (RGBA{144, 76, 42, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 0, 2), (RGBA{134, 66, 32, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 3), (RGBA{128, 60, 26, 255}));
+  // Modifiers of the second table are +5, +17, -5 and -17.
+  EXPECT_EQ(GetPixel(bitmap, 2, 0), (RGBA{22, 39, 56, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 1), (RGBA{34, 51, 68, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 2, 2), (RGBA{12, 29, 46, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 3), (RGBA{0, 17, 34, 255}));
+}
+
+TEST(KTX2ImageGeneratorTest, DecodesETC2DifferentialModeBlock) {
+  // The flip bit splits the block into a top sub-block with the base color
+  // 132, 66, 33 and a bottom sub-block with the base color 148, 41, 33. Pixel
+  // indices are the column number.
+  SkBitmap bitmap =
+      DecodeETC2Block({0x82, 0x45, 0x20, 0x5F, 0xFF, 0x00, 0xF0, 0xF0});
+  ASSERT_FALSE(bitmap.isNull());
+
+  // Modifiers of the third table are +9, +29, -9 and -29.
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{141, 75, 42, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 1), (RGBA{161, 95, 62, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 2, 0), (RGBA{123, 57, 24, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 1), (RGBA{103, 37, 4, 255}));
+  // Modifiers of the last table are +47, +183, -47 and -183, and the results
+  // are clamped.
+  EXPECT_EQ(GetPixel(bitmap, 0, 2), (RGBA{195, 88, 80, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 3), (RGBA{255, 224, 216, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 2, 2), (RGBA{101, 0, 0, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 3), (RGBA{0, 0, 0, 255}));
+}
+
+TEST(KTX2ImageGeneratorTest, DecodesETC2TModeBlock) {
+  // The base colors are 0xAA, 0x55, 0xFF and 0x33, 0x66, 0x99 with a distance
+  // of 16. Pixel indices are the column number.
+  SkBitmap bitmap =
+      DecodeETC2Block({0xF2, 0x5F, 0x36, 0x97, 0xFF, 0x00, 0xF0, 0xF0});
+  ASSERT_FALSE(bitmap.isNull());
+
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{170, 85, 255, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 1), (RGBA{67, 118, 169, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 2, 2), (RGBA{51, 102, 153, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 3), (RGBA{35, 86, 137, 255}));
+}
+
+TEST(KTX2ImageGeneratorTest, DecodesETC2HModeBlock) {
+  // The base colors are 0xCC, 0x66, 0x33 and 0x22, 0x99, 0x44. Since the first
+  // base color is larger, the lowest bit of the distance index is set, which
+  // selects a distance of 32. Pixel indices are the row number.
+  SkBitmap bitmap =
+      DecodeETC2Block({0x63, 0x05, 0x94, 0xA6, 0xCC, 0xCC, 0xAA, 0xAA});
+  ASSERT_FALSE(bitmap.isNull());
+
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{236, 134, 83, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 1), (RGBA{172, 70, 19, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 2, 2), (RGBA{66, 185, 100, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 3), (RGBA{2, 121, 36, 255}));
+}
+
+TEST(KTX2ImageGeneratorTest, DecodesETC2PlanarModeBlock) {
+  // The origin, horizontal and vertical colors are 40, 129, 65 and 162, 201,
+  // 20 and 255, 20, 162.
+  SkBitmap bitmap =
+      DecodeETC2Block({0x95, 0x00, 0x14, 0x52, 0xC8, 0x2F, 0xE2, 0xA8});
+  ASSERT_FALSE(bitmap.isNull());
+
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{40, 129, 65, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 0), (RGBA{132, 183, 31, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 0, 3), (RGBA{201, 47, 138, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 2), (RGBA{178, 93, 102, 255}));
+  // Red is clamped.
+  EXPECT_EQ(GetPixel(bitmap, 2, 3), (RGBA{255, 83, 115, 255}));
+  EXPECT_EQ(GetPixel(bitmap, 3, 3), (RGBA{255, 101, 104, 255}));
+}
+
+TEST(KTX2ImageGeneratorTest, DecodesETC2RGBA8Block) {
+  // The EAC alpha block has a base of 128, a multiplier of 3 and the modifier
+  // table -1, -2, -3, -10, 0, 1, 2, 9. The pixel indices are 0 to 7 in column
+  // major order, twice. The color block is an individual mode block.
+  std::vector<uint8_t> block = {0x80, 0x3D, 0x05, 0x39, 0x77, 0x05, 0x39, 0x77};
+  block.insert(block.end(), kIndividualBlock.begin(), kIndividualBlock.end());
+  SkBitmap bitmap =
+      DecodeLevel(MakeKTX2Texture(kETC2RGBA8, SkISize::Make(4, 4), {block}),
+                  SkISize::Make(4, 4), kUnpremul_SkAlphaType);
+  ASSERT_FALSE(bitmap.isNull());
+
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{138, 70, 36, 125}));
+  EXPECT_EQ(GetPixel(bitmap, 0, 1), (RGBA{144, 76, 42, 122}));
+  EXPECT_EQ(GetPixel(bitmap, 0, 2), (RGBA{134, 66, 32, 119}));
+  EXPECT_EQ(GetPixel(bitmap, 0, 3), (RGBA{128, 60, 26, 98}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 0), (RGBA{138, 70, 36, 128}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 1), (RGBA{144, 76, 42, 131}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 2), (RGBA{134, 66, 32, 134}));
+  EXPECT_EQ(GetPixel(bitmap, 1, 3), (RGBA{128, 60, 26, 155}));
+}
+
+TEST(KTX2ImageGeneratorTest, PremultipliesStraightAlpha) {
+  auto texture =
+      MakeKTX2Texture(kRGBA8, SkISize::Make(1, 1), {{255, 102, 0, 128}});
+  auto generator = KTX2ImageGenerator::MakeFromData(texture);
+  ASSERT_TRUE(generator);
+  EXPECT_EQ(generator->GetInfo().alphaType(), kPremul_SkAlphaType);
+
+  SkBitmap bitmap =
+      DecodeLevel(texture, SkISize::Make(1, 1), kPremul_SkAlphaType);
+  ASSERT_FALSE(bitmap.isNull());
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{128, 51, 0, 128}));
+}
+
+TEST(KTX2ImageGeneratorTest, KeepsPremultipliedAlpha) {
+  auto texture =
+      MakeKTX2Texture(kRGBA8, SkISize::Make(1, 1), {{128, 51, 0, 128}},
+                      /*premultiplied=*/true);
+  SkBitmap bitmap =
+      DecodeLevel(texture, SkISize::Make(1, 1), kPremul_SkAlphaType);
+  ASSERT_FALSE(bitmap.isNull());
+  EXPECT_EQ(GetPixel(bitmap, 0, 0), (RGBA{128, 51, 0, 128}));
+}
+
+TEST(KTX2ImageGeneratorTest, SwizzlesBGRALevels) {
+  const std::vector<uint8_t> base_level = {
+      0x11, 0x22, 0x33, 0xFF, 0x11, 0x22, 0x33, 0xFF,
+      0x11, 0x22, 0x33, 0xFF, 0x11, 0x22, 0x33, 0xFF,
+  };
+  const std::vector<uint8_t> mip_level = {0x44, 0x55, 0x66, 0xFF};
+  auto texture =
+      MakeKTX2Texture(kBGRA8, SkISize::Make(2, 2), {base_level, mip_level});
+
+  SkBitmap base =
+      DecodeLevel(texture, SkISize::Make(2, 2), kPremul_SkAlphaType);
+  ASSERT_FALSE(base.isNull());
+  EXPECT_EQ(GetPixel(base, 1, 1), (RGBA{0x33, 0x22, 0x11, 0xFF}));
+
+  SkBitmap mip = DecodeLevel(texture, SkISize::Make(1, 1), kPremul_SkAlphaType);
+  ASSERT_FALSE(mip.isNull());
+  EXPECT_EQ(GetPixel(mip, 0, 0), (RGBA{0x66, 0x55, 0x44, 0xFF}));
+}
+
+}  // namespace testing
+}  // namespace flutter
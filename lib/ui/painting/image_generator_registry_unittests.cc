@@ -3,12 +3,14 @@
 // found in the LICENSE file.
 
 #include "flutter/lib/ui/painting/image_generator_registry.h"
+#include "flutter/lib/ui/painting/image_generator_ktx2.h"
 
 #include "flutter/fml/mapping.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
 #include "third_party/skia/include/codec/SkCodecAnimation.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 
 namespace flutter {
 namespace testing {
@@ -150,5 +152,77 @@ TEST_F(ShellTest, ImageGeneratorsWithSamePriorityCascadeChronologically) {
   ASSERT_EQ(result->GetInfo().width(), 1337);
 }
 
+// Builds an 8x8 ETC2 RGB8 KTX2 texture with two mip levels. The base level is
+// made of individual mode blocks, the second level of a differential mode
+// block.
+static sk_sp<SkData> MakeETC2Texture() {
+  std::vector<uint8_t> bytes = {
+      0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n',
+  };
+  auto append = [&bytes](uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+  };
+  // vkFormat, typeSize, pixelWidth, pixelHeight, pixelDepth, layerCount,
+  // faceCount, levelCount, supercompressionScheme.
+  for (uint32_t value : {147u, 1u, 8u, 8u, 0u, 0u, 1u, 2u, 0u}) {
+    append(value, 4);
+  }
+  // No data format descriptor, key/value data or supercompression data.
+  for (int i = 0; i < 4; i++) {
+    append(0, 8);
+  }
+  // Level index.
+  append(128, 8);
+  append(32, 8);
+  append(32, 8);
+  append(160, 8);
+  append(8, 8);
+  append(8, 8);
+  for (int i = 0; i < 4; i++) {
+    bytes.insert(bytes.end(), {0x88, 0x44, 0x22, 0x00, 0, 0, 0, 0});
+  }
+  bytes.insert(bytes.end(), {0x80, 0x40, 0x20, 0x26, 0xFF, 0xFF, 0xFF, 0xFF});
+  return SkData::MakeWithCopy(bytes.data(), bytes.size());
+}
+
+TEST_F(ShellTest, CreateCompatibleReturnsKTX2ImageGeneratorForKTX2Texture) {
+  ImageGeneratorRegistry registry;
+  auto generator = registry.CreateCompatibleGenerator(MakeETC2Texture());
+  ASSERT_TRUE(generator);
+
+  const SkImageInfo& info = generator->GetInfo();
+  ASSERT_EQ(info.dimensions(), SkISize::Make(8, 8));
+  ASSERT_EQ(info.alphaType(), kOpaque_SkAlphaType);
+  // Scaled decodes select the smallest mip level covering the requested size.
+  ASSERT_EQ(generator->GetScaledDimensions(1.0), SkISize::Make(8, 8));
+  ASSERT_EQ(generator->GetScaledDimensions(0.75), SkISize::Make(8, 8));
+  ASSERT_EQ(generator->GetScaledDimensions(0.5), SkISize::Make(4, 4));
+  ASSERT_EQ(generator->GetScaledDimensions(0.1), SkISize::Make(4, 4));
+
+  SkBitmap base_level;
+  base_level.allocPixels(info);
+  ASSERT_TRUE(generator->GetPixels(base_level.info(), base_level.getPixels(),
+                                   base_level.rowBytes(), 0, std::nullopt));
+  // 0x88, 0x44, 0x22 offset by the smallest modifier of the first table.
+  EXPECT_EQ(base_level.getColor(0, 0), SkColorSetRGB(0x8A, 0x46, 0x24));
+  EXPECT_EQ(base_level.getColor(7, 7), SkColorSetRGB(0x8A, 0x46, 0x24));
+
+  SkBitmap mip_level;
+  mip_level.allocPixels(info.makeWH(4, 4));
+  ASSERT_TRUE(generator->GetPixels(mip_level.info(), mip_level.getPixels(),
+                                   mip_level.rowBytes(), 0, std::nullopt));
+  // 132, 66, 33 offset by the largest negative modifier of the second table.
+  EXPECT_EQ(mip_level.getColor(0, 0), SkColorSetRGB(115, 49, 16));
+  EXPECT_EQ(mip_level.getColor(3, 3), SkColorSetRGB(115, 49, 16));
+}
+
+TEST_F(ShellTest, KTX2ImageGeneratorRejectsTruncatedTexture) {
+  auto texture = MakeETC2Texture();
+  auto truncated = SkData::MakeSubset(texture.get(), 0, texture->size() - 1);
+  ASSERT_EQ(KTX2ImageGenerator::MakeFromData(truncated), nullptr);
+}
+
 }  // namespace testing
 }  // namespace flutter
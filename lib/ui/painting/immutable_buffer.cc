@@ -108,8 +108,7 @@ Dart_Handle ImmutableBuffer::initFromAsset(Dart_Handle raw_buffer_handle,
         size_t buffer_size = 0;
         if (mapping != nullptr) {
           buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          sk_data = MakeSkDataFromMapping(std::move(mapping));
         }
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
@@ -178,8 +177,7 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
         size_t buffer_size = 0;
         if (mapping->IsValid()) {
           buffer_size = mapping->GetSize();
-          const void* bytes = static_cast<const void*>(mapping->GetMapping());
-          sk_data = MakeSkDataWithCopy(bytes, buffer_size);
+          sk_data = MakeSkDataFromMapping(std::move(mapping));
         }
         ui_task_runner->PostTask(
             [sk_data = std::move(sk_data), ui_task = ui_task, buffer_size]() {
@@ -189,6 +187,23 @@ Dart_Handle ImmutableBuffer::initFromFile(Dart_Handle raw_buffer_handle,
   return Dart_Null();
 }
 
+sk_sp<SkData> ImmutableBuffer::MakeSkDataFromMapping(
+    std::unique_ptr<fml::Mapping> mapping) {
+  size_t length = mapping->GetSize();
+  if (length == 0 || !mapping->IsDontNeedSafe()) {
+    return MakeSkDataWithCopy(mapping->GetMapping(), length);
+  }
+
+  // File backed mappings are read only and are not allocated from the native
+  // heap, so the SkData can wrap them directly and avoid copying the asset.
+  fml::Mapping* mapping_ptr = mapping.release();
+  SkData::ReleaseProc proc = [](const void* ptr, void* context) {
+    delete reinterpret_cast<fml::Mapping*>(context);
+  };
+  return SkData::MakeWithProc(mapping_ptr->GetMapping(), length, proc,
+                              mapping_ptr);
+}
+
 #if FML_OS_ANDROID
 
 // Compressed image buffers are allocated on the UI thread but are deleted on a
@@ -8,6 +8,7 @@
 #include <cstdint>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
 #include "flutter/lib/ui/dart_wrapper.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/tonic/dart_library_natives.h"
@@ -89,6 +90,13 @@ class ImmutableBuffer : public RefCountedDartWrappable<ImmutableBuffer> {
     ClearDartWrapper();
   }
 
+  /// Creates an SkData that takes ownership of the mapping instead of copying
+  /// it when the mapping is backed by a file (see |Mapping::IsDontNeedSafe|).
+  /// Other mappings, such as those in anonymous or heap memory, are copied.
+  /// Visible for testing.
+  static sk_sp<SkData> MakeSkDataFromMapping(
+      std::unique_ptr<fml::Mapping> mapping);
+
  private:
   explicit ImmutableBuffer(sk_sp<SkData> data) : data_(std::move(data)) {}
 
@@ -0,0 +1,99 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/immutable_buffer.h"
+
+#include <cstring>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr char kContents[] = "Hello, ImmutableBuffer!";
+constexpr size_t kContentsLength = sizeof(kContents) - 1;
+
+std::unique_ptr<fml::FileMapping> MapFile(
+    fml::ScopedTemporaryDirectory& directory,
+    const char* name,
+    const char* contents) {
+  fml::UniqueFD file =
+      fml::OpenFile(directory.fd(), name, /*create_if_necessary=*/true,
+                    fml::FilePermission::kReadWrite);
+  if (!file.is_valid()) {
+    return nullptr;
+  }
+  fml::NonOwnedMapping mapping(reinterpret_cast<const uint8_t*>(contents),
+                               strlen(contents));
+  if (mapping.GetSize() > 0 &&
+      !fml::WriteAtomically(directory.fd(), name, mapping)) {
+    return nullptr;
+  }
+  return fml::FileMapping::CreateReadOnly(directory.fd(), name);
+}
+
+}  // namespace
+
+TEST(ImmutableBufferTest, WrapsFileMappingsWithoutCopy) {
+  fml::ScopedTemporaryDirectory directory;
+  std::unique_ptr<fml::FileMapping> mapping =
+      MapFile(directory, "asset", kContents);
+  ASSERT_TRUE(mapping && mapping->IsValid());
+  ASSERT_TRUE(mapping->IsDontNeedSafe());
+  const uint8_t* mapped = mapping->GetMapping();
+
+  sk_sp<SkData> sk_data =
+      ImmutableBuffer::MakeSkDataFromMapping(std::move(mapping));
+  ASSERT_TRUE(sk_data);
+  EXPECT_EQ(sk_data->data(), mapped);
+  EXPECT_EQ(sk_data->size(), kContentsLength);
+  EXPECT_EQ(memcmp(sk_data->data(), kContents, kContentsLength), 0);
+}
+
+TEST(ImmutableBufferTest, CopiesHeapMappings) {
+  auto malloc_mapping =
+      std::make_unique<fml::MallocMapping>(fml::MallocMapping::Copy(
+          reinterpret_cast<const uint8_t*>(kContents), kContentsLength));
+  const uint8_t* malloc_data = malloc_mapping->GetMapping();
+  sk_sp<SkData> sk_data =
+      ImmutableBuffer::MakeSkDataFromMapping(std::move(malloc_mapping));
+  ASSERT_TRUE(sk_data);
+  EXPECT_NE(sk_data->data(), malloc_data);
+  EXPECT_EQ(sk_data->size(), kContentsLength);
+  EXPECT_EQ(memcmp(sk_data->data(), kContents, kContentsLength), 0);
+
+  auto data_mapping = std::make_unique<fml::DataMapping>(kContents);
+  const uint8_t* data_data = data_mapping->GetMapping();
+  sk_data = ImmutableBuffer::MakeSkDataFromMapping(std::move(data_mapping));
+  ASSERT_TRUE(sk_data);
+  EXPECT_NE(sk_data->data(), data_data);
+  EXPECT_EQ(sk_data->size(), kContentsLength);
+  EXPECT_EQ(memcmp(sk_data->data(), kContents, kContentsLength), 0);
+}
+
+TEST(ImmutableBufferTest, CopiesEmptyMappings) {
+  // An empty file has no mapped memory that the SkData could wrap.
+  fml::ScopedTemporaryDirectory directory;
+  std::unique_ptr<fml::FileMapping> file_mapping =
+      MapFile(directory, "empty", "");
+  ASSERT_TRUE(file_mapping && file_mapping->IsValid());
+  ASSERT_EQ(file_mapping->GetSize(), 0u);
+  sk_sp<SkData> sk_data =
+      ImmutableBuffer::MakeSkDataFromMapping(std::move(file_mapping));
+  ASSERT_TRUE(sk_data);
+  EXPECT_EQ(sk_data->size(), 0u);
+
+  sk_data = ImmutableBuffer::MakeSkDataFromMapping(
+      std::make_unique<fml::DataMapping>(std::vector<uint8_t>{}));
+  ASSERT_TRUE(sk_data);
+  EXPECT_EQ(sk_data->size(), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,427 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/incremental_image_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/image.h"
+#include "flutter/lib/ui/painting/image_descriptor.h"
+#include "flutter/lib/ui/ui_dart_state.h"
+#include "third_party/skia/include/codec/SkCodec.h"
+#include "third_party/skia/include/codec/SkEncodedOrigin.h"
+#include "third_party/skia/include/codec/SkPixmapUtils.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkPixelRef.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/tonic/converter/dart_converter.h"
+#include "third_party/tonic/logging/dart_invoke.h"
+
+namespace flutter {
+
+IMPLEMENT_WRAPPERTYPEINFO(ui, IncrementalImageDecoder);
+
+class IncrementalImageDecoder::EncodedBuffer {
+ public:
+  void Append(const uint8_t* data, size_t length) {
+    std::scoped_lock lock(mutex_);
+    FML_DCHECK(!closed_);
+    bytes_.insert(bytes_.end(), data, data + length);
+  }
+
+  void Close() {
+    std::scoped_lock lock(mutex_);
+    closed_ = true;
+  }
+
+  bool IsClosed() const {
+    std::scoped_lock lock(mutex_);
+    return closed_;
+  }
+
+  size_t GetSize() const {
+    std::scoped_lock lock(mutex_);
+    return bytes_.size();
+  }
+
+  // Copies up to |length| bytes starting at |offset| into |dst|, which may be
+  // null to skip them. Returns the number of bytes available.
+  size_t Read(size_t offset, void* dst, size_t length) const {
+    std::scoped_lock lock(mutex_);
+    if (offset >= bytes_.size()) {
+      return 0;
+    }
+    length = std::min(length, bytes_.size() - offset);
+    if (dst) {
+      memcpy(dst, bytes_.data() + offset, length);
+    }
+    return length;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<uint8_t> bytes_;
+  bool closed_ = false;
+};
+
+class IncrementalImageDecoder::EncodedBufferStream : public SkStream {
+ public:
+  explicit EncodedBufferStream(std::shared_ptr<const EncodedBuffer> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  size_t read(void* buffer, size_t size) override {
+    size_t bytes_read = buffer_->Read(position_, buffer, size);
+    position_ += bytes_read;
+    return bytes_read;
+  }
+
+  size_t peek(void* buffer, size_t size) const override {
+    return buffer_->Read(position_, buffer, size);
+  }
+
+  bool isAtEnd() const override {
+    return buffer_->IsClosed() && position_ >= buffer_->GetSize();
+  }
+
+  bool rewind() override {
+    position_ = 0;
+    return true;
+  }
+
+ private:
+  const std::shared_ptr<const EncodedBuffer> buffer_;
+  size_t position_ = 0;
+};
+
+class IncrementalImageDecoder::State {
+ public:
+  explicit State(std::shared_ptr<EncodedBuffer> buffer)
+      : buffer_(std::move(buffer)) {}
+
+  // Decodes the bytes received so far. The returned frame has no pixels if
+  // there weren't enough bytes to start decoding.
+  Frame DecodeAvailable() {
+    TRACE_EVENT0("flutter", "IncrementalImageDecoder::DecodeAvailable");
+    // Checked before decoding so that bytes received during the decode can't
+    // complete a frame that was decoded without them.
+    const bool has_all_bytes = buffer_->IsClosed();
+
+    if (!codec_) {
+      SkCodec::Result result;
+      codec_ = SkCodec::MakeFromStream(
+          std::make_unique<EncodedBufferStream>(buffer_), &result);
+      if (!codec_) {
+        if (result == SkCodec::kIncompleteInput && !has_all_bytes) {
+          return {};
+        }
+        return MakeErrorFrame(std::string("Invalid image data: ") +
+                              SkCodec::ResultToString(result));
+      }
+      const SkImageInfo info = codec_->getInfo()
+                                   .makeColorType(kRGBA_8888_SkColorType)
+                                   .makeAlphaType(kPremul_SkAlphaType)
+                                   .makeColorSpace(SkColorSpace::MakeSRGB());
+      if (!bitmap_.tryAllocPixels(info)) {
+        return MakeErrorFrame("Failed to allocate memory for bitmap of size " +
+                              std::to_string(info.computeMinByteSize()) + "B");
+      }
+      // Rows that haven't been received yet are shown as transparent.
+      bitmap_.eraseColor(SK_ColorTRANSPARENT);
+    }
+
+    if (!decode_started_) {
+      const SkCodec::Result result = codec_->startIncrementalDecode(
+          bitmap_.info(), bitmap_.getPixels(), bitmap_.rowBytes());
+      if (result == SkCodec::kSuccess) {
+        incremental_ = true;
+      } else if (result == SkCodec::kUnimplemented) {
+        // Formats like JPEG can only be decoded as a whole. The bytes received
+        // so far are decoded again for every frame.
+        incremental_ = false;
+      } else if (result == SkCodec::kIncompleteInput && !has_all_bytes) {
+        return {};
+      } else {
+        return MakeErrorFrame(std::string("Could not start decoding image: ") +
+                              SkCodec::ResultToString(result));
+      }
+      decode_started_ = true;
+    }
+
+    const SkCodec::Result result = incremental_
+                                       ? codec_->incrementalDecode()
+                                       : codec_->getPixels(bitmap_.pixmap());
+    switch (result) {
+      case SkCodec::kSuccess:
+        return MakeFrame(true);
+      case SkCodec::kIncompleteInput:
+      case SkCodec::kErrorInInput:
+        // A truncated image shows the rows that were decoded, like an image
+        // decoded by the |ImageDecoder| does.
+        return MakeFrame(has_all_bytes);
+      default:
+        return MakeErrorFrame(std::string("Could not decode image: ") +
+                              SkCodec::ResultToString(result));
+    }
+  }
+
+ private:
+  const std::shared_ptr<EncodedBuffer> buffer_;
+  std::unique_ptr<SkCodec> codec_;
+  SkBitmap bitmap_;
+  bool decode_started_ = false;
+  bool incremental_ = false;
+
+  static Frame MakeErrorFrame(std::string decode_error) {
+    FML_DLOG(ERROR) << decode_error;
+    Frame frame;
+    frame.is_complete = true;
+    frame.decode_error = std::move(decode_error);
+    return frame;
+  }
+
+  Frame MakeFrame(bool is_complete) {
+    Frame frame;
+    frame.is_complete = is_complete;
+    const SkEncodedOrigin origin = codec_->getOrigin();
+    if (origin != kTopLeft_SkEncodedOrigin) {
+      frame.info = bitmap_.info();
+      if (SkEncodedOriginSwapsWidthHeight(origin)) {
+        frame.info = SkPixmapUtils::SwapWidthHeight(frame.info);
+      }
+      frame.row_bytes = frame.info.minRowBytes();
+      auto pixels = SkData::MakeUninitialized(
+          frame.info.computeByteSize(frame.row_bytes));
+      SkPixmap oriented(frame.info, pixels->writable_data(), frame.row_bytes);
+      if (!SkPixmapUtils::Orient(oriented, bitmap_.pixmap(), origin)) {
+        return MakeErrorFrame("Could not orient image");
+      }
+      frame.pixels = std::move(pixels);
+    } else {
+      frame.info = bitmap_.info();
+      frame.row_bytes = bitmap_.rowBytes();
+      if (is_complete) {
+        // Nothing decodes into the bitmap anymore, so its pixels are handed
+        // over instead of copied.
+        frame.pixels = SkData::MakeWithProc(
+            bitmap_.getPixels(), bitmap_.computeByteSize(),
+            [](const void*, void* pixel_ref) {
+              static_cast<SkPixelRef*>(pixel_ref)->unref();
+            },
+            SkSafeRef(bitmap_.pixelRef()));
+      } else {
+        frame.pixels = SkData::MakeWithCopy(bitmap_.getPixels(),
+                                            bitmap_.computeByteSize());
+      }
+    }
+    if (is_complete) {
+      codec_.reset();
+      bitmap_.reset();
+    }
+    return frame;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(State);
+};
+
+void IncrementalImageDecoder::Create(Dart_Handle wrapper,
+                                     int min_frame_interval_ms,
+                                     Dart_Handle callback_handle) {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  auto decoder = fml::MakeRefCounted<IncrementalImageDecoder>(
+      fml::TimeDelta::FromMilliseconds(std::max(min_frame_interval_ms, 0)),
+      callback_handle);
+  decoder->AssociateWithDartWrapper(wrapper);
+}
+
+IncrementalImageDecoder::IncrementalImageDecoder(
+    fml::TimeDelta min_frame_interval,
+    Dart_Handle callback_handle)
+    : min_frame_interval_(min_frame_interval),
+      callback_(UIDartState::Current(), callback_handle),
+      buffer_(std::make_shared<EncodedBuffer>()),
+      state_(std::make_shared<State>(buffer_)),
+      weak_factory_(this) {
+  auto* dart_state = UIDartState::Current();
+  ui_task_runner_ = dart_state->GetTaskRunners().GetUITaskRunner();
+  concurrent_task_runner_ = dart_state->GetConcurrentTaskRunner();
+  image_decoder_ = dart_state->GetImageDecoder();
+}
+
+IncrementalImageDecoder::~IncrementalImageDecoder() = default;
+
+void IncrementalImageDecoder::addChunk(const tonic::Uint8List& chunk) {
+  if (is_closed_ || chunk.num_elements() == 0) {
+    return;
+  }
+  buffer_->Append(chunk.data(), chunk.num_elements());
+  has_new_bytes_ = true;
+  ScheduleDecode();
+}
+
+void IncrementalImageDecoder::close() {
+  if (is_closed_) {
+    return;
+  }
+  is_closed_ = true;
+  buffer_->Close();
+  // The last frame is decoded even if no bytes arrived since the previous
+  // one, because it may complete a truncated image.
+  has_new_bytes_ = true;
+  ScheduleDecode();
+}
+
+void IncrementalImageDecoder::dispose() {
+  is_closed_ = true;
+  buffer_.reset();
+  state_.reset();
+  callback_.Clear();
+  ClearDartWrapper();
+}
+
+void IncrementalImageDecoder::ScheduleDecode() {
+  if (!state_ || !has_new_bytes_ || decode_in_flight_) {
+    return;
+  }
+  // Once all bytes have arrived, the final frame isn't held back.
+  if (!is_closed_) {
+    if (decode_scheduled_) {
+      return;
+    }
+    const fml::TimeDelta delay =
+        last_frame_time_ + min_frame_interval_ - fml::TimePoint::Now();
+    if (delay > fml::TimeDelta::Zero()) {
+      decode_scheduled_ = true;
+      ui_task_runner_->PostDelayedTask(
+          [weak = weak_factory_.GetWeakPtr()]() {
+            if (weak) {
+              weak->decode_scheduled_ = false;
+              weak->ScheduleDecode();
+            }
+          },
+          delay);
+      return;
+    }
+  }
+  StartDecode();
+}
+
+void IncrementalImageDecoder::StartDecode() {
+  has_new_bytes_ = false;
+  decode_in_flight_ = true;
+  last_frame_time_ = fml::TimePoint::Now();
+  concurrent_task_runner_->PostTask(
+      [state = state_, ui_task_runner = ui_task_runner_,
+       weak = weak_factory_.GetWeakPtr()]() {
+        Frame frame = state->DecodeAvailable();
+        ui_task_runner->PostTask([weak, frame = std::move(frame)]() {
+          if (weak) {
+            weak->OnFrameDecoded(frame);
+          }
+        });
+      });
+}
+
+void IncrementalImageDecoder::OnFrameDecoded(Frame frame) {
+  decode_in_flight_ = false;
+  if (!state_) {
+    // Disposed while decoding.
+    return;
+  }
+  if (!frame.decode_error.empty()) {
+    Finish(nullptr, frame.decode_error);
+    return;
+  }
+  if (!frame.pixels) {
+    ScheduleDecode();
+    return;
+  }
+  if (!image_decoder_) {
+    Finish(nullptr,
+           "Failed to access the internal image decoder "
+           "registry on this isolate. Please file a bug on "
+           "https://github.com/flutter/flutter/issues.");
+    return;
+  }
+  if (frame.is_complete) {
+    // The encoded bytes and the codec aren't needed while the last frame is
+    // uploaded.
+    is_closed_ = true;
+    state_.reset();
+    buffer_.reset();
+  }
+
+  const int width = frame.info.width();
+  const int height = frame.info.height();
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      std::move(frame.pixels), frame.info, frame.row_bytes);
+  // Uploads count as in flight so that frames reach Dart in order.
+  decode_in_flight_ = true;
+  image_decoder_->Decode(
+      descriptor, width, height,
+      [weak = weak_factory_.GetWeakPtr(), is_complete = frame.is_complete](
+          sk_sp<DlImage> image, const std::string& decode_error) {
+        if (weak) {
+          weak->OnFrameUploaded(std::move(image), is_complete, decode_error);
+        }
+      });
+}
+
+void IncrementalImageDecoder::OnFrameUploaded(sk_sp<DlImage> image,
+                                              bool is_complete,
+                                              const std::string& decode_error) {
+  decode_in_flight_ = false;
+  if (is_complete) {
+    Finish(std::move(image), decode_error);
+    return;
+  }
+  // A partial frame that failed to upload is skipped. The next one may not.
+  if (image) {
+    InvokeCallback(std::move(image), false, "");
+  }
+  ScheduleDecode();
+}
+
+void IncrementalImageDecoder::Finish(sk_sp<DlImage> image,
+                                     const std::string& decode_error) {
+  is_closed_ = true;
+  state_.reset();
+  buffer_.reset();
+  InvokeCallback(std::move(image), true, decode_error);
+  callback_.Clear();
+}
+
+void IncrementalImageDecoder::InvokeCallback(sk_sp<DlImage> image,
+                                             bool is_complete,
+                                             const std::string& decode_error) {
+  if (callback_.is_empty()) {
+    return;
+  }
+  auto dart_state = callback_.dart_state().lock();
+  if (!dart_state) {
+    // This is probably because the isolate has been terminated before the
+    // image could be decoded.
+    return;
+  }
+  // The callback may dispose this decoder.
+  fml::RefPtr<IncrementalImageDecoder> self(this);
+  tonic::DartState::Scope scope(dart_state.get());
+
+  fml::RefPtr<CanvasImage> canvas_image;
+  if (image) {
+    canvas_image = fml::MakeRefCounted<CanvasImage>();
+    canvas_image->set_image(std::move(image));
+  }
+  tonic::DartInvoke(callback_.value(),
+                    {tonic::ToDart(canvas_image), tonic::ToDart(is_complete),
+                     tonic::ToDart(decode_error)});
+}
+
+}  // namespace flutter
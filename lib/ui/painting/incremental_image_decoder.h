@@ -0,0 +1,130 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+#define FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
+
+#include <memory>
+#include <string>
+
+#include "flutter/display_list/image/dl_image.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/task_runner.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/dart_wrapper.h"
+#include "flutter/lib/ui/painting/image_decoder.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/tonic/dart_persistent_value.h"
+#include "third_party/tonic/typed_data/typed_list.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Decodes a still image while its encoded bytes arrive, for
+///             instance over a slow network connection.
+///
+///             Codecs that support incremental decoding, like those for
+///             interlaced PNGs and GIFs, continue where they stopped whenever
+///             more bytes have arrived. Other codecs, like the one for
+///             progressive JPEGs, decode all of the bytes received so far
+///             again. The partially decoded frames are uploaded and handed to
+///             Dart at most once per minimum frame interval.
+///
+///             Once the image is complete, the codec and the encoded bytes are
+///             released and the decoded pixels are handed to the upload
+///             without a copy, so nothing is retained beyond the memory of a
+///             regular decode.
+///
+///             This object must be created, accessed and collected on the UI
+///             thread. Decoding happens on the concurrent worker runner.
+///
+class IncrementalImageDecoder
+    : public RefCountedDartWrappable<IncrementalImageDecoder> {
+  DEFINE_WRAPPERTYPEINFO();
+  FML_FRIEND_MAKE_REF_COUNTED(IncrementalImageDecoder);
+
+ public:
+  ~IncrementalImageDecoder() override;
+
+  static void Create(Dart_Handle wrapper,
+                     int min_frame_interval_ms,
+                     Dart_Handle callback_handle);
+
+  /// @brief  Append the next bytes of the encoded image.
+  void addChunk(const tonic::Uint8List& chunk);
+
+  /// @brief  Signal that all bytes of the encoded image have been added.
+  void close();
+
+  void dispose();
+
+ private:
+  // The encoded bytes received so far. Appended to on the UI thread and read
+  // by the codec on a worker.
+  class EncodedBuffer;
+
+  // A stream over the bytes received so far. Reads past them come up short,
+  // which the codecs treat as incomplete input that a later decode continues.
+  class EncodedBufferStream;
+
+  // The codec and the pixels it decodes into. Only accessed by the worker
+  // that decodes the next frame.
+  class State;
+
+  // The pixels decoded from the bytes that were available to a decode.
+  struct Frame {
+    sk_sp<SkData> pixels;
+    SkImageInfo info;
+    size_t row_bytes = 0;
+    // Whether no further frames will follow.
+    bool is_complete = false;
+    std::string decode_error;
+  };
+
+  const fml::TimeDelta min_frame_interval_;
+  tonic::DartPersistentValue callback_;
+  fml::RefPtr<fml::TaskRunner> ui_task_runner_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> concurrent_task_runner_;
+  fml::WeakPtr<ImageDecoder> image_decoder_;
+  std::shared_ptr<EncodedBuffer> buffer_;
+  std::shared_ptr<State> state_;
+  fml::TimePoint last_frame_time_;
+  bool has_new_bytes_ = false;
+  bool is_closed_ = false;
+  bool decode_in_flight_ = false;
+  bool decode_scheduled_ = false;
+  fml::WeakPtrFactory<IncrementalImageDecoder> weak_factory_;
+
+  IncrementalImageDecoder(fml::TimeDelta min_frame_interval,
+                          Dart_Handle callback_handle);
+
+  // Decodes the bytes that have arrived since the last frame, unless a decode
+  // is in flight or the last frame was emitted less than the minimum frame
+  // interval ago.
+  void ScheduleDecode();
+
+  void StartDecode();
+
+  void OnFrameDecoded(Frame frame);
+
+  void OnFrameUploaded(sk_sp<DlImage> image,
+                       bool is_complete,
+                       const std::string& decode_error);
+
+  // Releases everything but the pixels of the last frame.
+  void Finish(sk_sp<DlImage> image, const std::string& decode_error);
+
+  void InvokeCallback(sk_sp<DlImage> image,
+                      bool is_complete,
+                      const std::string& decode_error);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(IncrementalImageDecoder);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_LIB_UI_PAINTING_INCREMENTAL_IMAGE_DECODER_H_
@@ -4,7 +4,10 @@
 
 #include "flutter/lib/ui/painting/multi_frame_codec.h"
 
+#include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/make_copyable.h"
 #include "flutter/lib/ui/painting/display_list_image_gpu.h"
@@ -21,19 +24,160 @@
 
 namespace flutter {
 
+namespace {
+
+// The uploaded frames of short animations, retained so that subsequent loops
+// don't have to decode and upload them again. All codecs in the process share
+// a budget for them.
+class CachedLoops {
+ public:
+  static CachedLoops& GetInstance() {
+    static CachedLoops* instance = new CachedLoops();
+    return *instance;
+  }
+
+  // Reserve |bytes| of the budget for the |frame_count| frames of a loop.
+  // Returns the id of the loop, or 0 if the budget is exhausted.
+  size_t Reserve(size_t bytes, int frame_count, size_t max_bytes) {
+    std::scoped_lock lock(mutex_);
+    if (reserved_bytes_ + bytes > max_bytes) {
+      return 0;
+    }
+    reserved_bytes_ += bytes;
+    const size_t id = next_id_++;
+    loops_[id] = {.bytes = bytes, .frames = std::vector<Frame>(frame_count)};
+    return id;
+  }
+
+  // Retain a frame of the loop. Returns whether all of its frames are
+  // retained.
+  bool AddFrame(size_t id,
+                int index,
+                const sk_sp<DlImage>& image,
+                int duration) {
+    std::scoped_lock lock(mutex_);
+    auto it = loops_.find(id);
+    if (it == loops_.end()) {
+      return false;
+    }
+    Loop& loop = it->second;
+    if (!loop.frames[index].image) {
+      loop.frames[index] = {image, duration};
+      loop.cached_frame_count++;
+    }
+    return loop.cached_frame_count == loop.frames.size();
+  }
+
+  bool GetFrame(size_t id, int index, sk_sp<DlImage>& image, int& duration) {
+    std::scoped_lock lock(mutex_);
+    auto it = loops_.find(id);
+    if (it == loops_.end() || !it->second.frames[index].image) {
+      return false;
+    }
+    image = it->second.frames[index].image;
+    duration = it->second.frames[index].duration;
+    return true;
+  }
+
+  void Release(size_t id) {
+    Loop loop;
+    {
+      std::scoped_lock lock(mutex_);
+      auto it = loops_.find(id);
+      if (it == loops_.end()) {
+        return;
+      }
+      loop = std::move(it->second);
+      loops_.erase(it);
+      reserved_bytes_ -= loop.bytes;
+    }
+    // The images are collected outside of the lock.
+  }
+
+  void ReleaseAll() {
+    std::unordered_map<size_t, Loop> loops;
+    {
+      std::scoped_lock lock(mutex_);
+      loops.swap(loops_);
+      reserved_bytes_ = 0;
+    }
+  }
+
+ private:
+  struct Frame {
+    sk_sp<DlImage> image;
+    int duration = 0;
+  };
+
+  struct Loop {
+    size_t bytes = 0;
+    std::vector<Frame> frames;
+    size_t cached_frame_count = 0;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<size_t, Loop> loops_;
+  size_t reserved_bytes_ = 0;
+  size_t next_id_ = 1;
+
+  CachedLoops() = default;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(CachedLoops);
+};
+
+// Reserve the budget to retain the frames of an animation, unless it is a
+// single frame or larger than |max_loop_bytes|.
+size_t ReserveCachedLoop(const ImageGenerator& generator,
+                         int frame_count,
+                         size_t max_loop_bytes,
+                         size_t max_process_bytes) {
+  if (frame_count <= 1) {
+    return 0;
+  }
+  const size_t bytes =
+      frame_count *
+      generator.GetInfo().makeColorType(kN32_SkColorType).computeMinByteSize();
+  if (bytes > max_loop_bytes) {
+    return 0;
+  }
+  return CachedLoops::GetInstance().Reserve(bytes, frame_count,
+                                            max_process_bytes);
+}
+
+}  // namespace
+
 MultiFrameCodec::MultiFrameCodec(std::shared_ptr<ImageGenerator> generator)
-    : state_(new State(std::move(generator))) {}
+    : state_(new State(std::move(generator),
+                       UIDartState::Current()->IsImpellerEnabled())) {}
 
 MultiFrameCodec::~MultiFrameCodec() = default;
 
-MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator)
+void MultiFrameCodec::dispose() {
+  CachedLoops::GetInstance().Release(state_->cachedLoopId_);
+  Codec::dispose();
+}
+
+void MultiFrameCodec::PurgeCachedFrames() {
+  CachedLoops::GetInstance().ReleaseAll();
+}
+
+MultiFrameCodec::State::State(std::shared_ptr<ImageGenerator> generator,
+                              bool is_impeller_enabled)
     : generator_(std::move(generator)),
       frameCount_(generator_->GetFrameCount()),
       repetitionCount_(generator_->GetPlayCount() ==
                                ImageGenerator::kInfinitePlayCount
                            ? -1
                            : generator_->GetPlayCount() - 1),
-      is_impeller_enabled_(UIDartState::Current()->IsImpellerEnabled()) {}
+      is_impeller_enabled_(is_impeller_enabled),
+      cachedLoopId_(ReserveCachedLoop(*generator_,
+                                      frameCount_,
+                                      kMaxCachedLoopBytes,
+                                      kMaxCachedLoopBytesForProcess)) {}
+
+MultiFrameCodec::State::~State() {
+  CachedLoops::GetInstance().Release(cachedLoopId_);
+}
 
 static void InvokeNextFrameCallback(
     const fml::RefPtr<CanvasImage>& image,
@@ -53,12 +197,11 @@ static void InvokeNextFrameCallback(
                      tonic::ToDart(decode_error)});
 }
 
-std::pair<sk_sp<DlImage>, std::string>
-MultiFrameCodec::State::GetNextFrameImage(
-    fml::WeakPtr<GrDirectContext> resourceContext,
-    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
-    const std::shared_ptr<impeller::Context>& impeller_context,
-    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+MultiFrameCodec::State::DecodedFrame
+MultiFrameCodec::State::DecodeNextFrame() {
+  const int frameIndex = decodeFrameIndex_;
+  decodeFrameIndex_ = (decodeFrameIndex_ + 1) % frameCount_;
+
   SkBitmap bitmap = SkBitmap();
   SkImageInfo info = generator_->GetInfo().makeColorType(kN32_SkColorType);
   if (info.alphaType() == kUnpremul_SkAlphaType) {
@@ -71,11 +214,10 @@ MultiFrameCodec::State::GetNextFrameImage(
          << info.computeMinByteSize() << "B";
     std::string decode_error = ostr.str();
     FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    return {.decode_error = decode_error};
   }
 
-  ImageGenerator::FrameInfo frameInfo =
-      generator_->GetFrameInfo(nextFrameIndex_);
+  ImageGenerator::FrameInfo frameInfo = generator_->GetFrameInfo(frameIndex);
 
   const int requiredFrameIndex =
       frameInfo.required_frame.value_or(SkCodec::kNoFrame);
@@ -86,7 +228,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // |requiredFrameIndex| is set to ex-frame or ex-ex-frame.
     if (!lastRequiredFrame_.has_value()) {
       FML_DLOG(INFO)
-          << "Frame " << nextFrameIndex_ << " depends on frame "
+          << "Frame " << frameIndex << " depends on frame "
           << requiredFrameIndex
           << " and no required frames are cached. Using blank slate instead.";
     } else {
@@ -102,12 +244,12 @@ MultiFrameCodec::State::GetNextFrameImage(
   // Write the new frame to the output buffer. The bitmap pixels as supplied
   // are already set in accordance with the previous frame's disposal policy.
   if (!generator_->GetPixels(info, bitmap.getPixels(), bitmap.rowBytes(),
-                             nextFrameIndex_, requiredFrameIndex)) {
+                             frameIndex, requiredFrameIndex)) {
     std::ostringstream ostr;
-    ostr << "Could not getPixels for frame " << nextFrameIndex_;
+    ostr << "Could not getPixels for frame " << frameIndex;
     std::string decode_error = ostr.str();
     FML_LOG(ERROR) << decode_error;
-    return std::make_pair(nullptr, decode_error);
+    return {.decode_error = decode_error};
   }
 
   const bool keep_current_frame =
@@ -132,7 +274,7 @@ MultiFrameCodec::State::GetNextFrameImage(
     // Replace the stored frame. The `lastRequiredFrame_` will get used as the
     // starting backdrop for the next frame.
     lastRequiredFrame_ = bitmap;
-    lastRequiredFrameIndex_ = nextFrameIndex_;
+    lastRequiredFrameIndex_ = frameIndex;
   }
 
   if (frameInfo.disposal_method ==
@@ -142,6 +284,85 @@ MultiFrameCodec::State::GetNextFrameImage(
     restoreBGColorRect_.reset();
   }
 
+  return {.bitmap = bitmap};
+}
+
+void MultiFrameCodec::State::DecodeLookAheadFrames() {
+  while (lookAheadFrames_.size() < kMaxLookAheadFrames && !isLoopCached_ &&
+         HasFramesToDecode()) {
+    lookAheadFrames_.push_back(DecodeNextFrame());
+  }
+}
+
+bool MultiFrameCodec::State::HasFramesToDecode() const {
+  if (repetitionCount_ < 0) {
+    return true;
+  }
+  const int64_t playedFrameCount =
+      static_cast<int64_t>(frameCount_) * (repetitionCount_ + 1);
+  return requestedFrameCount_ +
+             static_cast<int64_t>(lookAheadFrames_.size()) <
+         playedFrameCount;
+}
+
+bool MultiFrameCodec::State::GetCachedFrame(sk_sp<DlImage>& image,
+                                            int& duration) {
+  if (!isLoopCached_) {
+    return false;
+  }
+  if (CachedLoops::GetInstance().GetFrame(cachedLoopId_, nextFrameIndex_,
+                                          image, duration)) {
+    return true;
+  }
+  // The frames were released on dispose or a low memory warning. Frames may be
+  // composited on top of earlier ones, so decoding starts over from the first
+  // frame to catch up with the requested one.
+  isLoopCached_ = false;
+  lookAheadFrames_.clear();
+  lastRequiredFrame_.reset();
+  lastRequiredFrameIndex_ = -1;
+  restoreBGColorRect_.reset();
+  decodeFrameIndex_ = 0;
+  while (decodeFrameIndex_ != nextFrameIndex_) {
+    DecodeNextFrame();
+  }
+  return false;
+}
+
+void MultiFrameCodec::State::CacheFrame(const sk_sp<DlImage>& image,
+                                        int duration) {
+  // Only retain frames that don't have to be uploaded again when drawn.
+  if (cachedLoopId_ == 0 || !image->isTextureBacked()) {
+    return;
+  }
+  if (CachedLoops::GetInstance().AddFrame(cachedLoopId_, nextFrameIndex_,
+                                          image, duration)) {
+    isLoopCached_ = true;
+    // Decoding state is no longer needed.
+    lookAheadFrames_.clear();
+    lastRequiredFrame_.reset();
+    lastRequiredFrameIndex_ = -1;
+  }
+}
+
+std::pair<sk_sp<DlImage>, std::string>
+MultiFrameCodec::State::GetNextFrameImage(
+    fml::WeakPtr<GrDirectContext> resourceContext,
+    const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue) {
+  DecodedFrame frame;
+  if (lookAheadFrames_.empty()) {
+    frame = DecodeNextFrame();
+  } else {
+    frame = std::move(lookAheadFrames_.front());
+    lookAheadFrames_.pop_front();
+  }
+  if (!frame.bitmap.has_value()) {
+    return std::make_pair(nullptr, frame.decode_error);
+  }
+  SkBitmap& bitmap = frame.bitmap.value();
+
 #if IMPELLER_SUPPORTS_RENDERING
   if (is_impeller_enabled_) {
     // This is safe regardless of whether the GPU is available or not because
@@ -189,22 +410,29 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
     fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
     const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
     size_t trace_id,
-    const std::shared_ptr<impeller::Context>& impeller_context) {
+    const std::shared_ptr<impeller::Context>& impeller_context,
+    const fml::RefPtr<fml::TaskRunner>& io_task_runner) {
   fml::RefPtr<CanvasImage> image = nullptr;
   int duration = 0;
   sk_sp<DlImage> dlImage;
   std::string decode_error;
-  std::tie(dlImage, decode_error) =
-      GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
-                        impeller_context, std::move(unref_queue));
+  if (!GetCachedFrame(dlImage, duration)) {
+    std::tie(dlImage, decode_error) =
+        GetNextFrameImage(std::move(resourceContext), gpu_disable_sync_switch,
+                          impeller_context, std::move(unref_queue));
+    if (dlImage) {
+      ImageGenerator::FrameInfo frameInfo =
+          generator_->GetFrameInfo(nextFrameIndex_);
+      duration = frameInfo.duration;
+      CacheFrame(dlImage, duration);
+    }
+  }
   if (dlImage) {
     image = CanvasImage::Create();
     image->set_image(dlImage);
-    ImageGenerator::FrameInfo frameInfo =
-        generator_->GetFrameInfo(nextFrameIndex_);
-    duration = frameInfo.duration;
   }
   nextFrameIndex_ = (nextFrameIndex_ + 1) % frameCount_;
+  requestedFrameCount_++;
 
   // The static leak checker gets confused by the use of fml::MakeCopyable.
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -214,6 +442,17 @@ void MultiFrameCodec::State::GetNextFrameAndInvokeCallback(
         InvokeNextFrameCallback(image, duration, decode_error,
                                 std::move(callback), trace_id);
       }));
+
+  // Decode the upcoming frames in a separate task so that other work on the
+  // IO task runner may be interleaved. Nothing is decoded past the last loop
+  // of a finite animation.
+  if (frameCount_ > 1 && !isLoopCached_ && HasFramesToDecode()) {
+    io_task_runner->PostTask([weak_state = weak_from_this()]() {
+      if (auto state = weak_state.lock()) {
+        state->DecodeLookAheadFrames();
+      }
+    });
+  }
 }
 
 Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
@@ -246,6 +485,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
            tonic::DartState::Current(), callback_handle),
        weak_state = std::weak_ptr<MultiFrameCodec::State>(state_), trace_id,
        ui_task_runner = task_runners.GetUITaskRunner(),
+       io_task_runner = task_runners.GetIOTaskRunner(),
        io_manager = dart_state->GetIOManager()]() mutable {
         auto state = weak_state.lock();
         if (!state) {
@@ -257,7 +497,7 @@ Dart_Handle MultiFrameCodec::getNextFrame(Dart_Handle callback_handle) {
             std::move(callback), ui_task_runner,
             io_manager->GetResourceContext(), io_manager->GetSkiaUnrefQueue(),
             io_manager->GetIsGpuDisabledSyncSwitch(), trace_id,
-            io_manager->GetImpellerContext());
+            io_manager->GetImpellerContext(), io_task_runner);
       }));
 
   return Dart_Null();
@@ -9,6 +9,7 @@
 #include "flutter/lib/ui/painting/codec.h"
 #include "flutter/lib/ui/painting/image_generator.h"
 
+#include <deque>
 #include <utility>
 
 namespace flutter {
@@ -28,7 +29,21 @@ class MultiFrameCodec : public Codec {
   // |Codec|
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
+  // |Codec|
+  void dispose() override;
+
+  /// Release the uploaded frames that codecs retain for subsequent loops of
+  /// their animations, in response to a low memory warning.
+  static void PurgeCachedFrames();
+
  private:
+  FML_FRIEND_TEST(MultiFrameCodecTest, DecodesFramesInOrder);
+  FML_FRIEND_TEST(MultiFrameCodecTest, CompositesFramesOnTheirRequiredFrame);
+  FML_FRIEND_TEST(MultiFrameCodecTest, StopsDecodingAfterTheLastLoop);
+  FML_FRIEND_TEST(MultiFrameCodecTest, ServesCachedLoopWithoutDecoding);
+  FML_FRIEND_TEST(MultiFrameCodecTest, DecodesAgainAfterCachedFramesArePurged);
+  FML_FRIEND_TEST(MultiFrameCodecTest, CachedLoopsShareAProcessBudget);
+
   // Captures the state shared between the IO and UI task runners.
   //
   // The state is initialized on the UI task runner when the Dart object is
@@ -38,18 +53,56 @@ class MultiFrameCodec : public Codec {
   // Instead, the MultiFrameCodec creates this object when it is constructed,
   // shares it with the IO task runner's decoding work, and sets the live_
   // member to false when it is destructed.
-  struct State {
-    explicit State(std::shared_ptr<ImageGenerator> generator);
+  struct State : public std::enable_shared_from_this<State> {
+    State(std::shared_ptr<ImageGenerator> generator, bool is_impeller_enabled);
+
+    ~State();
+
+    // The maximum number of frames that are decoded ahead of the frame that
+    // was last requested.
+    static constexpr size_t kMaxLookAheadFrames = 2u;
+
+    // The maximum size of all frames of an animation for its frames to be
+    // retained after they have been uploaded once.
+    static constexpr size_t kMaxCachedLoopBytes = 8u * 1024u * 1024u;
+
+    // The maximum size of the retained frames of all animations in the
+    // process.
+    static constexpr size_t kMaxCachedLoopBytesForProcess =
+        32u * 1024u * 1024u;
 
     const std::shared_ptr<ImageGenerator> generator_;
     const int frameCount_;
     const int repetitionCount_;
     bool is_impeller_enabled_ = false;
+    // The id under which the uploaded frames of this animation are retained
+    // for subsequent loops, or 0 if the animation is too large or the budget
+    // of the process is exhausted.
+    const size_t cachedLoopId_;
 
     // The non-const members and functions below here are only read or written
     // to on the IO thread. They are not safe to access or write on the UI
     // thread.
     int nextFrameIndex_ = 0;
+    // The index of the next frame to decode. This is ahead of
+    // |nextFrameIndex_| by the number of |lookAheadFrames_|.
+    int decodeFrameIndex_ = 0;
+
+    struct DecodedFrame {
+      std::optional<SkBitmap> bitmap;
+      std::string decode_error;
+    };
+    // Frames that have been decoded ahead of being requested, starting with
+    // the frame at |nextFrameIndex_|.
+    std::deque<DecodedFrame> lookAheadFrames_;
+
+    // The number of frames that have been requested, over all loops.
+    int64_t requestedFrameCount_ = 0;
+
+    // Whether all frames are retained under |cachedLoopId_| and decoding has
+    // stopped.
+    bool isLoopCached_ = false;
+
     // The last decoded frame that's required to decode any subsequent frames.
     std::optional<SkBitmap> lastRequiredFrame_;
     // The index of the last decoded required frame.
@@ -59,6 +112,26 @@ class MultiFrameCodec : public Codec {
     // method was kRestoreBGColor.
     std::optional<SkIRect> restoreBGColorRect_;
 
+    // Decode the frame at |decodeFrameIndex_| on top of the frame it depends
+    // on, and advance |decodeFrameIndex_|.
+    DecodedFrame DecodeNextFrame();
+
+    // Top up |lookAheadFrames_| so that upcoming frames only need to be
+    // uploaded when they are requested.
+    void DecodeLookAheadFrames();
+
+    // Whether frames after those in |lookAheadFrames_| will be requested. This
+    // is false once the last loop of a finite animation has been decoded.
+    bool HasFramesToDecode() const;
+
+    // Get the retained frame at |nextFrameIndex_| if the loop is cached. If
+    // the retained frames were released, decoding starts over so that it
+    // catches up with |nextFrameIndex_|.
+    bool GetCachedFrame(sk_sp<DlImage>& image, int& duration);
+
+    // Retain the uploaded frame at |nextFrameIndex_| for subsequent loops.
+    void CacheFrame(const sk_sp<DlImage>& image, int duration);
+
     std::pair<sk_sp<DlImage>, std::string> GetNextFrameImage(
         fml::WeakPtr<GrDirectContext> resourceContext,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
@@ -72,7 +145,8 @@ class MultiFrameCodec : public Codec {
         fml::RefPtr<flutter::SkiaUnrefQueue> unref_queue,
         const std::shared_ptr<const fml::SyncSwitch>& gpu_disable_sync_switch,
         size_t trace_id,
-        const std::shared_ptr<impeller::Context>& impeller_context);
+        const std::shared_ptr<impeller::Context>& impeller_context,
+        const fml::RefPtr<fml::TaskRunner>& io_task_runner);
   };
 
   // Shared across the UI and IO task runners.
@@ -0,0 +1,263 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/lib/ui/painting/multi_frame_codec.h"
+
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "third_party/skia/include/codec/SkCodecAnimation.h"
+
+namespace flutter {
+
+namespace {
+
+class MockDlImage : public DlImage {
+ public:
+  MOCK_METHOD(sk_sp<SkImage>, skia_image, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<impeller::Texture>,
+              impeller_texture,
+              (),
+              (const, override));
+  MOCK_METHOD(bool, isOpaque, (), (const, override));
+  MOCK_METHOD(bool, isTextureBacked, (), (const, override));
+  MOCK_METHOD(bool, isUIThreadSafe, (), (const, override));
+  MOCK_METHOD(SkISize, dimensions, (), (const, override));
+  MOCK_METHOD(size_t, GetApproximateByteSize, (), (const, override));
+};
+
+sk_sp<DlImage> MakeTextureImage() {
+  auto image = sk_make_sp<::testing::NiceMock<MockDlImage>>();
+  ON_CALL(*image, isTextureBacked).WillByDefault(::testing::Return(true));
+  return image;
+}
+
+/// An image generator that fills the left |width| columns of each frame with
+/// the frame's color and records the frames that are requested.
+class RecordingImageGenerator : public ImageGenerator {
+ public:
+  struct Frame {
+    SkColor color = SK_ColorTRANSPARENT;
+    int width = 0;
+    std::optional<unsigned int> required_frame;
+  };
+
+  struct Request {
+    unsigned int frame_index;
+    std::optional<unsigned int> prior_frame;
+  };
+
+  RecordingImageGenerator(SkISize size,
+                          std::vector<Frame> frames,
+                          unsigned int play_count)
+      : info_(SkImageInfo::MakeN32Premul(size.width(), size.height())),
+        frames_(std::move(frames)),
+        play_count_(play_count) {}
+
+  ~RecordingImageGenerator() = default;
+
+  const SkImageInfo& GetInfo() override { return info_; }
+
+  unsigned int GetFrameCount() const override { return frames_.size(); }
+
+  unsigned int GetPlayCount() const override { return play_count_; }
+
+  const ImageGenerator::FrameInfo GetFrameInfo(
+      unsigned int frame_index) override {
+    return {frames_[frame_index].required_frame, 0,
+            SkCodecAnimation::DisposalMethod::kKeep};
+  }
+
+  SkISize GetScaledDimensions(float scale) override {
+    return info_.dimensions();
+  }
+
+  bool GetPixels(const SkImageInfo& info,
+                 void* pixels,
+                 size_t row_bytes,
+                 unsigned int frame_index,
+                 std::optional<unsigned int> prior_frame) override {
+    requests_.push_back({frame_index, prior_frame});
+    SkBitmap bitmap;
+    bitmap.installPixels(info, pixels, row_bytes);
+    const Frame& frame = frames_[frame_index];
+    bitmap.erase(frame.color, SkIRect::MakeWH(frame.width, info.height()));
+    return true;
+  }
+
+  const std::vector<Request>& requests() const { return requests_; }
+
+ private:
+  SkImageInfo info_;
+  std::vector<Frame> frames_;
+  unsigned int play_count_;
+  std::vector<Request> requests_;
+};
+
+std::shared_ptr<RecordingImageGenerator> MakeGenerator(
+    int frame_count,
+    unsigned int play_count = ImageGenerator::kInfinitePlayCount) {
+  std::vector<RecordingImageGenerator::Frame> frames;
+  for (int i = 0; i < frame_count; i++) {
+    frames.push_back({.color = SK_ColorRED, .width = 4});
+  }
+  return std::make_shared<RecordingImageGenerator>(
+      SkISize::Make(4, 2), std::move(frames), play_count);
+}
+
+}  // namespace
+
+TEST(MultiFrameCodecTest, DecodesFramesInOrder) {
+  auto generator = MakeGenerator(3);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, /*is_impeller_enabled=*/false);
+
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(state->DecodeNextFrame().bitmap.has_value());
+  }
+
+  ASSERT_EQ(generator->requests().size(), 4u);
+  EXPECT_EQ(generator->requests()[0].frame_index, 0u);
+  EXPECT_EQ(generator->requests()[1].frame_index, 1u);
+  EXPECT_EQ(generator->requests()[2].frame_index, 2u);
+  EXPECT_EQ(generator->requests()[3].frame_index, 0u);
+}
+
+TEST(MultiFrameCodecTest, CompositesFramesOnTheirRequiredFrame) {
+  // The second frame only draws the left half and keeps the first frame
+  // underneath.
+  auto generator = std::make_shared<RecordingImageGenerator>(
+      SkISize::Make(4, 2),
+      std::vector<RecordingImageGenerator::Frame>{
+          {.color = SK_ColorRED, .width = 4},
+          {.color = SK_ColorGREEN, .width = 2, .required_frame = 0},
+      },
+      ImageGenerator::kInfinitePlayCount);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, /*is_impeller_enabled=*/false);
+
+  ASSERT_TRUE(state->DecodeNextFrame().bitmap.has_value());
+  std::optional<SkBitmap> bitmap = state->DecodeNextFrame().bitmap;
+  ASSERT_TRUE(bitmap.has_value());
+
+  ASSERT_EQ(generator->requests().size(), 2u);
+  EXPECT_EQ(generator->requests()[1].prior_frame, 0u);
+  EXPECT_EQ(bitmap->getColor(0, 0), SK_ColorGREEN);
+  EXPECT_EQ(bitmap->getColor(3, 1), SK_ColorRED);
+}
+
+TEST(MultiFrameCodecTest, StopsDecodingAfterTheLastLoop) {
+  auto generator = MakeGenerator(3, /*play_count=*/1);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, /*is_impeller_enabled=*/false);
+
+  state->DecodeLookAheadFrames();
+  EXPECT_EQ(generator->requests().size(), 2u);
+
+  // Request the first frame, leaving one more frame to decode.
+  state->lookAheadFrames_.pop_front();
+  state->nextFrameIndex_ = 1;
+  state->requestedFrameCount_ = 1;
+  state->DecodeLookAheadFrames();
+  EXPECT_EQ(generator->requests().size(), 3u);
+
+  // Request the remaining frames. The animation doesn't loop.
+  state->lookAheadFrames_.clear();
+  state->nextFrameIndex_ = 0;
+  state->requestedFrameCount_ = 3;
+  EXPECT_FALSE(state->HasFramesToDecode());
+  state->DecodeLookAheadFrames();
+  EXPECT_EQ(generator->requests().size(), 3u);
+}
+
+TEST(MultiFrameCodecTest, ServesCachedLoopWithoutDecoding) {
+  auto generator = MakeGenerator(2);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, /*is_impeller_enabled=*/false);
+  ASSERT_NE(state->cachedLoopId_, 0u);
+
+  std::vector<sk_sp<DlImage>> images = {MakeTextureImage(),
+                                        MakeTextureImage()};
+  for (int i = 0; i < 2; i++) {
+    sk_sp<DlImage> image;
+    int duration = 0;
+    EXPECT_FALSE(state->GetCachedFrame(image, duration));
+    state->DecodeNextFrame();
+    state->CacheFrame(images[i], 10 + i);
+    state->nextFrameIndex_ = (state->nextFrameIndex_ + 1) % 2;
+  }
+  EXPECT_TRUE(state->isLoopCached_);
+  const size_t decoded_frame_count = generator->requests().size();
+
+  for (int i = 0; i < 4; i++) {
+    sk_sp<DlImage> image;
+    int duration = 0;
+    ASSERT_TRUE(state->GetCachedFrame(image, duration));
+    EXPECT_EQ(image, images[i % 2]);
+    EXPECT_EQ(duration, 10 + i % 2);
+    state->nextFrameIndex_ = (state->nextFrameIndex_ + 1) % 2;
+  }
+  state->DecodeLookAheadFrames();
+  EXPECT_EQ(generator->requests().size(), decoded_frame_count);
+}
+
+TEST(MultiFrameCodecTest, DecodesAgainAfterCachedFramesArePurged) {
+  auto generator = MakeGenerator(3);
+  auto state = std::make_shared<MultiFrameCodec::State>(
+      generator, /*is_impeller_enabled=*/false);
+  for (int i = 0; i < 3; i++) {
+    state->DecodeNextFrame();
+    state->CacheFrame(MakeTextureImage(), 0);
+    state->nextFrameIndex_ = (state->nextFrameIndex_ + 1) % 3;
+  }
+  ASSERT_TRUE(state->isLoopCached_);
+  state->nextFrameIndex_ = 2;
+
+  MultiFrameCodec::PurgeCachedFrames();
+
+  sk_sp<DlImage> image;
+  int duration = 0;
+  EXPECT_FALSE(state->GetCachedFrame(image, duration));
+  EXPECT_FALSE(state->isLoopCached_);
+  // Decoding catches up with the requested frame from the first frame.
+  EXPECT_EQ(state->decodeFrameIndex_, 2);
+  ASSERT_EQ(generator->requests().size(), 5u);
+  EXPECT_EQ(generator->requests()[3].frame_index, 0u);
+  EXPECT_EQ(generator->requests()[4].frame_index, 1u);
+
+  // The released frames are not retained again.
+  state->DecodeNextFrame();
+  state->CacheFrame(MakeTextureImage(), 0);
+  EXPECT_FALSE(state->GetCachedFrame(image, duration));
+}
+
+TEST(MultiFrameCodecTest, CachedLoopsShareAProcessBudget) {
+  // Each loop takes all of the budget for a single animation.
+  const SkISize size = SkISize::Make(1024, 1024);
+  auto make_state = [&size]() {
+    return std::make_shared<MultiFrameCodec::State>(
+        std::make_shared<RecordingImageGenerator>(
+            size, std::vector<RecordingImageGenerator::Frame>(2),
+            ImageGenerator::kInfinitePlayCount),
+        /*is_impeller_enabled=*/false);
+  };
+  const size_t loop_count =
+      MultiFrameCodec::State::kMaxCachedLoopBytesForProcess /
+      MultiFrameCodec::State::kMaxCachedLoopBytes;
+
+  std::vector<std::shared_ptr<MultiFrameCodec::State>> states;
+  for (size_t i = 0; i < loop_count; i++) {
+    states.push_back(make_state());
+    EXPECT_NE(states.back()->cachedLoopId_, 0u);
+  }
+  EXPECT_EQ(make_state()->cachedLoopId_, 0u);
+
+  // Collecting a codec returns its share of the budget.
+  states.pop_back();
+  EXPECT_NE(make_state()->cachedLoopId_, 0u);
+}
+
+}  // namespace flutter
@@ -12,10 +12,13 @@ namespace flutter {
 SingleFrameCodec::SingleFrameCodec(
     const fml::RefPtr<ImageDescriptor>& descriptor,
     uint32_t target_width,
-    uint32_t target_height)
+    uint32_t target_height,
+    ImageDecodePriority priority)
     : descriptor_(descriptor),
       target_width_(target_width),
-      target_height_(target_height) {}
+      target_height_(target_height),
+      priority_(priority),
+      cancelled_(std::make_shared<std::atomic_bool>(false)) {}
 
 SingleFrameCodec::~SingleFrameCodec() = default;
 
@@ -27,6 +30,11 @@ int SingleFrameCodec::repetitionCount() const {
   return 0;
 }
 
+void SingleFrameCodec::dispose() {
+  cancelled_->store(true);
+  Codec::dispose();
+}
+
 Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
   if (!Dart_IsClosure(callback_handle)) {
     return tonic::ToDart("Callback must be a function");
@@ -85,6 +93,22 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
 
         tonic::DartState::Scope scope(state.get());
 
+        if (codec->cancelled_->load()) {
+          // The codec was disposed before the frame was decoded, and the decode
+          // may have been skipped. Fail the callbacks so that the futures
+          // waiting for the frame complete.
+          for (const tonic::DartPersistentValue& callback :
+               codec->pending_callbacks_) {
+            tonic::DartInvoke(
+                callback.value(),
+                {Dart_Null(), tonic::ToDart(0),
+                 tonic::ToDart("Decode was cancelled because the codec was "
+                               "disposed.")});
+          }
+          codec->pending_callbacks_.clear();
+          return;
+        }
+
         if (image) {
           auto canvas_image = fml::MakeRefCounted<CanvasImage>();
           canvas_image->set_image(std::move(image));
@@ -104,7 +128,8 @@ Dart_Handle SingleFrameCodec::getNextFrame(Dart_Handle callback_handle) {
                              tonic::ToDart(0), tonic::ToDart(decode_error)});
         }
         codec->pending_callbacks_.clear();
-      });
+      },
+      {.priority = priority_, .cancelled = cancelled_});
 
   // The encoded data is no longer needed now that it has been handed off
   // to the decoder.
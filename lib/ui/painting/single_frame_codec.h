@@ -15,9 +15,11 @@ namespace flutter {
 
 class SingleFrameCodec : public Codec {
  public:
-  SingleFrameCodec(const fml::RefPtr<ImageDescriptor>& descriptor,
-                   uint32_t target_width,
-                   uint32_t target_height);
+  SingleFrameCodec(
+      const fml::RefPtr<ImageDescriptor>& descriptor,
+      uint32_t target_width,
+      uint32_t target_height,
+      ImageDecodePriority priority = ImageDecodePriority::kNormal);
 
   ~SingleFrameCodec() override;
 
@@ -30,12 +32,18 @@ class SingleFrameCodec : public Codec {
   // |Codec|
   Dart_Handle getNextFrame(Dart_Handle args) override;
 
+  // |Codec|
+  void dispose() override;
+
  private:
   enum class Status { kNew, kInProgress, kComplete };
   Status status_ = Status::kNew;
   fml::RefPtr<ImageDescriptor> descriptor_;
   uint32_t target_width_;
   uint32_t target_height_;
+  ImageDecodePriority priority_;
+  // Set when the codec is disposed so that a queued decode is skipped.
+  std::shared_ptr<std::atomic_bool> cancelled_;
   fml::RefPtr<CanvasImage> cached_image_;
   std::vector<tonic::DartPersistentValue> pending_callbacks_;
 
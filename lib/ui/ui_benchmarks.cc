@@ -4,13 +4,25 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/common/settings.h"
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/painting/image_decode_queue.h"
+#include "flutter/lib/ui/painting/image_descriptor.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
 #include "flutter/runtime/dart_vm_lifecycle.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/dart_isolate_runner.h"
 #include "flutter/testing/fixture_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/core/testing/test_impeller_allocator.h"
+#include "flutter/lib/ui/painting/image_decoder_impeller.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
 
 #include <future>
+#include <thread>
 
 namespace flutter {
 
@@ -69,4 +81,117 @@ static void BM_PlatformMessageResponseDartComplete(benchmark::State& state) {
 BENCHMARK(BM_PlatformMessageResponseDartComplete)
     ->Unit(benchmark::kMicrosecond);
 
+// Simulates a fling through a gallery grid. The decodes of the images that were
+// scrolled past are queued ahead of the decodes of the images the grid comes to
+// rest on. Measures the time until the images on screen are decoded.
+//
+// The first argument is the `ImageDecodePriority` of the images on screen. The
+// images that were scrolled past are decoded with a low priority. The second
+// argument is whether the codecs of the images scrolled past are disposed.
+static void BM_ImageDecodeQueueTimeToVisibleImage(benchmark::State& state) {
+  constexpr size_t kScrolledPastImageCount = 48;
+  constexpr size_t kVisibleImageCount = 8;
+  const auto visible_priority =
+      static_cast<ImageDecodePriority>(state.range(0));
+  const bool dispose_scrolled_past = state.range(1) != 0;
+
+  auto loop = fml::ConcurrentMessageLoop::Create(2);
+  auto queue = std::make_shared<ImageDecodeQueue>(loop->GetTaskRunner());
+  // Stands in for decoding a thumbnail.
+  auto decode = [] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+
+  while (state.KeepRunning()) {
+    fml::CountDownLatch visible_latch(kVisibleImageCount);
+    fml::CountDownLatch all_latch(kScrolledPastImageCount + kVisibleImageCount);
+    auto scrolled_past = std::make_shared<std::atomic_bool>(false);
+    const auto start = fml::TimePoint::Now();
+    for (size_t i = 0; i < kScrolledPastImageCount; i++) {
+      queue->Push(
+          ImageDecodePriority::kLow, scrolled_past,
+          [&]() {
+            decode();
+            all_latch.CountDown();
+          },
+          [&]() { all_latch.CountDown(); });
+    }
+    if (dispose_scrolled_past) {
+      scrolled_past->store(true);
+    }
+    for (size_t i = 0; i < kVisibleImageCount; i++) {
+      queue->Push(
+          visible_priority, nullptr,
+          [&]() {
+            decode();
+            visible_latch.CountDown();
+            all_latch.CountDown();
+          },
+          [&]() { all_latch.CountDown(); });
+    }
+    visible_latch.Wait();
+    state.SetIterationTime((fml::TimePoint::Now() - start).ToSecondsF());
+    all_latch.Wait();
+  }
+}
+
+BENCHMARK(BM_ImageDecodeQueueTimeToVisibleImage)
+    ->Args({static_cast<int>(ImageDecodePriority::kLow), 0})
+    ->Args({static_cast<int>(ImageDecodePriority::kHigh), 0})
+    ->Args({static_cast<int>(ImageDecodePriority::kHigh), 1})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+#if IMPELLER_SUPPORTS_RENDERING
+// Measures the conversion of raw pixels of the given format into the upload
+// buffer of a 1024x1024 texture.
+static void BM_ImpellerDecompressRawPixels(benchmark::State& state,
+                                           SkColorType color_type,
+                                           SkAlphaType alpha_type,
+                                           bool supports_wide_gamut) {
+  const auto info = SkImageInfo::Make(1024, 1024, color_type, alpha_type);
+  SkBitmap bitmap;
+  bitmap.allocPixels(info);
+  bitmap.eraseColor(SkColor4f{0.8f, 0.4f, 0.2f, 0.5f});
+  auto descriptor = fml::MakeRefCounted<ImageDescriptor>(
+      SkData::MakeWithCopy(bitmap.getPixels(), bitmap.computeByteSize()), info,
+      bitmap.rowBytes());
+  std::shared_ptr<impeller::Allocator> allocator =
+      std::make_shared<impeller::TestImpellerAllocator>();
+
+  while (state.KeepRunning()) {
+    auto result = ImageDecoderImpeller::DecompressTexture(
+        descriptor.get(), info.dimensions(), {2048, 2048}, supports_wide_gamut,
+        allocator);
+    FML_CHECK(result.device_buffer);
+  }
+  state.SetBytesProcessed(state.iterations() * bitmap.computeByteSize());
+}
+
+BENCHMARK_CAPTURE(BM_ImpellerDecompressRawPixels,
+                  RGBA8888Premul,
+                  kRGBA_8888_SkColorType,
+                  kPremul_SkAlphaType,
+                  false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImpellerDecompressRawPixels,
+                  RGBA8888Unpremul,
+                  kRGBA_8888_SkColorType,
+                  kUnpremul_SkAlphaType,
+                  false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImpellerDecompressRawPixels,
+                  BGRA8888Unpremul,
+                  kBGRA_8888_SkColorType,
+                  kUnpremul_SkAlphaType,
+                  false)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ImpellerDecompressRawPixels,
+                  RGBAF32UnpremulToF16,
+                  kRGBA_F32_SkColorType,
+                  kUnpremul_SkAlphaType,
+                  true)
+    ->Unit(benchmark::kMicrosecond);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 }  // namespace flutter
@@ -653,11 +653,64 @@ class Codec {
   void dispose() {}
 }
 
+enum ImageDecodePriority {
+  low,
+  normal,
+  high,
+}
+
+typedef IncrementalImageCallback = void Function(Image image, bool isComplete);
+
+// The browser can't decode partial images, so the image is decoded once all
+// of its bytes have been added.
+class IncrementalImageDecoder {
+  IncrementalImageDecoder({
+    required this.onImage,
+    this.minFrameInterval = const Duration(milliseconds: 100),
+  });
+
+  final IncrementalImageCallback onImage;
+  final Duration minFrameInterval;
+
+  final BytesBuilder _bytes = BytesBuilder(copy: false);
+  Future<void>? _done;
+  bool _disposed = false;
+
+  void addChunk(Uint8List chunk) {
+    assert(_done == null, 'Cannot add bytes to a closed IncrementalImageDecoder.');
+    _bytes.add(chunk);
+  }
+
+  Future<void> close() => _done ??= _decode();
+
+  Future<void> _decode() async {
+    final Codec codec = await instantiateImageCodec(_bytes.takeBytes());
+    final FrameInfo frame;
+    try {
+      frame = await codec.getNextFrame();
+    } finally {
+      codec.dispose();
+    }
+    if (_disposed) {
+      frame.image.dispose();
+      return Completer<void>().future;
+    }
+    onImage(frame.image, true);
+  }
+
+  void dispose() {
+    _disposed = true;
+    _bytes.clear();
+  }
+}
+
+// The browser schedules image decodes, so the priority is ignored.
 Future<Codec> instantiateImageCodec(
   Uint8List list, {
   int? targetWidth,
   int? targetHeight,
   bool allowUpscaling = true,
+  ImageDecodePriority priority = ImageDecodePriority.normal,
 }) => engine.renderer.instantiateImageCodec(
   list,
   targetWidth: targetWidth,
@@ -669,6 +722,7 @@ Future<Codec> instantiateImageCodecFromBuffer(
   int? targetWidth,
   int? targetHeight,
   bool allowUpscaling = true,
+  ImageDecodePriority priority = ImageDecodePriority.normal,
 }) => engine.renderer.instantiateImageCodec(
   buffer._list!,
   targetWidth: targetWidth,
@@ -678,6 +732,7 @@ Future<Codec> instantiateImageCodecFromBuffer(
 Future<Codec> instantiateImageCodecWithSize(
   ImmutableBuffer buffer, {
   TargetImageSizeCallback? getTargetSize,
+  ImageDecodePriority priority = ImageDecodePriority.normal,
 }) async {
   if (getTargetSize == null) {
     return engine.renderer.instantiateImageCodec(buffer._list!);
@@ -15,6 +15,8 @@
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+#include "flutter/lib/ui/painting/multi_frame_codec.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/serialization_callbacks.h"
 #include "fml/closure.h"
@@ -168,6 +170,8 @@ void Rasterizer::DisableThreadMergerIfNeeded() {
 }
 
 void Rasterizer::NotifyLowMemoryWarning() const {
+  DecodedImageCache::GetCacheForProcess()->Purge();
+  MultiFrameCodec::PurgeCachedFrames();
 #if !SLIMPELLER
   if (!surface_) {
     FML_DLOG(INFO)
@@ -820,7 +824,8 @@ Rasterizer::ViewRecord& Rasterizer::EnsureViewRecord(int64_t view_id) {
 
 static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
     flutter::LayerTree* tree,
-    flutter::CompositorContext& compositor_context) {
+    flutter::CompositorContext& compositor_context,
+    int png_zlib_level) {
 #if SLIMPELLER
   return nullptr;
 #else  // SLIMPELLER
@@ -847,9 +852,12 @@ static sk_sp<SkData> ScreenshotLayerTreeAsPicture(
 #else
   SkSerialProcs procs = {0};
   procs.fTypefaceProc = SerializeTypefaceWithData;
-  procs.fImageProc = [](SkImage* img, void*) -> sk_sp<SkData> {
-    return SkPngEncoder::Encode(nullptr, img, SkPngEncoder::Options{});
+  procs.fImageProc = [](SkImage* img, void* ctx) -> sk_sp<SkData> {
+    SkPngEncoder::Options options;
+    options.fZLibLevel = *static_cast<int*>(ctx);
+    return SkPngEncoder::Encode(nullptr, img, options);
   };
+  procs.fImageCtx = &png_zlib_level;
 #endif
 
   return recorder.finishRecordingAsPicture()->serialize(&procs);
@@ -1018,8 +1026,10 @@ Rasterizer::ScreenshotLayerTreeAsImage(
   RenderFrameForScreenshot(compositor_context, canvas, tree, surface_context,
                            nullptr);
 
-  return std::make_pair(snapshot_surface->GetRasterData(compressed),
-                        ScreenshotFormat::kUnknown);
+  return std::make_pair(
+      snapshot_surface->GetRasterData(
+          compressed, delegate_.GetSettings().screenshot_png_zlib_level),
+      ScreenshotFormat::kUnknown);
 #endif  //  !SLIMPELLER
 }
 
@@ -1050,8 +1060,9 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   switch (type) {
     case ScreenshotType::SkiaPicture:
       format = "ScreenshotType::SkiaPicture";
-      data.first =
-          ScreenshotLayerTreeAsPicture(layer_tree, *compositor_context_);
+      data.first = ScreenshotLayerTreeAsPicture(
+          layer_tree, *compositor_context_,
+          delegate_.GetSettings().screenshot_png_zlib_level);
       break;
     case ScreenshotType::UncompressedImage:
       format = "ScreenshotType::UncompressedImage";
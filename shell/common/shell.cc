@@ -22,6 +22,8 @@
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
+#include "flutter/lib/ui/painting/decoded_image_disk_cache.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
 #include "flutter/shell/common/engine.h"
@@ -780,6 +782,19 @@ bool Shell::Setup(std::unique_ptr<PlatformView> platform_view,
   }
 #endif  //  !SLIMPELLER
 
+  if (settings_.purge_persistent_cache &&
+      settings_.enable_decoded_image_disk_cache) {
+    DecodedImageDiskCache::GetCacheForProcess()->Purge();
+  }
+
+  // The cache is shared by all shells in the process. Only shells that set a
+  // budget explicitly change it, so that a shell with the default settings
+  // doesn't reset the budget chosen for another shell.
+  if (settings_.decoded_image_cache_max_bytes.has_value()) {
+    DecodedImageCache::GetCacheForProcess()->SetMaxBytes(
+        settings_.decoded_image_cache_max_bytes.value());
+  }
+
   return true;
 }
 
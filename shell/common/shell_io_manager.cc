@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "flutter/fml/message_loop.h"
+#include "flutter/lib/ui/painting/decoded_image_cache.h"
 #include "flutter/shell/common/context_options.h"
 #include "third_party/skia/include/gpu/ganesh/gl/GrGLDirectContext.h"
 #include "third_party/skia/include/gpu/ganesh/gl/GrGLInterface.h"
@@ -69,6 +70,12 @@ ShellIOManager::~ShellIOManager() {
   // underlying OpenGL context may be going away.
   is_gpu_disabled_sync_switch_->Execute(
       fml::SyncSwitch::Handlers().SetIfFalse([&] { unref_queue_->Drain(); }));
+  // Shared decoded images must not keep textures of the Impeller context alive
+  // past its shutdown either.
+  if (impeller_context_) {
+    DecodedImageCache::GetCacheForProcess()->PurgeOwner(
+        impeller_context_.get());
+  }
 }
 
 void ShellIOManager::NotifyResourceContextAvailable(
@@ -504,6 +504,27 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.purge_persistent_cache =
       command_line.HasOption(FlagForSwitch(Switch::PurgePersistentCache));
 
+  settings.enable_decoded_image_disk_cache = command_line.HasOption(
+      FlagForSwitch(Switch::EnableDecodedImageDiskCache));
+
+  if (command_line.HasOption(
+          FlagForSwitch(Switch::DecodedImageCacheMaxBytes))) {
+    std::string decoded_image_cache_max_bytes;
+    command_line.GetOptionValue(
+        FlagForSwitch(Switch::DecodedImageCacheMaxBytes),
+        &decoded_image_cache_max_bytes);
+    settings.decoded_image_cache_max_bytes =
+        std::stoull(decoded_image_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::ScreenshotPngZLibLevel))) {
+    std::string screenshot_png_zlib_level;
+    command_line.GetOptionValue(FlagForSwitch(Switch::ScreenshotPngZLibLevel),
+                                &screenshot_png_zlib_level);
+    settings.screenshot_png_zlib_level =
+        std::clamp(std::stoi(screenshot_png_zlib_level), 0, 9);
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::OldGenHeapSize))) {
     std::string old_gen_heap_size;
     command_line.GetOptionValue(FlagForSwitch(Switch::OldGenHeapSize),
@@ -527,6 +548,9 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.disable_surface_control = command_line.HasOption(
       FlagForSwitch(Switch::DisableAndroidSurfaceControl));
 
+  settings.disable_msaa_on_cpu_devices = command_line.HasOption(
+      FlagForSwitch(Switch::DisableMSAAOnCPUDevices));
+
   return settings;
 }
 
@@ -191,6 +191,21 @@ DEF_SWITCH(PurgePersistentCache,
            "purge-persistent-cache",
            "Remove all existing persistent cache. This is mainly for debugging "
            "purposes such as reproducing the shader compilation jank.")
+DEF_SWITCH(EnableDecodedImageDiskCache,
+           "enable-decoded-image-disk-cache",
+           "Store the pixels of images that are expensive to decode on disk so "
+           "that later launches can skip decoding them. Only supported by the "
+           "Impeller renderer.")
+DEF_SWITCH(DecodedImageCacheMaxBytes,
+           "decoded-image-cache-max-bytes",
+           "The max bytes of decoded images shared between identical image "
+           "requests, or 0 to disable sharing them. Only supported by the "
+           "Impeller renderer.")
+DEF_SWITCH(ScreenshotPngZLibLevel,
+           "screenshot-png-zlib-level",
+           "The zlib compression level, from 0 to 9, of the PNG images in "
+           "screenshots taken by tooling. Lower levels encode faster but "
+           "produce larger images. Defaults to 6.")
 DEF_SWITCH(
     TraceSystrace,
     "trace-systrace",
@@ -300,6 +315,10 @@ DEF_SWITCH(EnableMergedPlatformUIThread,
 DEF_SWITCH(DisableAndroidSurfaceControl,
            "disable-surface-control",
            "Disable the SurfaceControl backed swapchain even when supported.")
+DEF_SWITCH(DisableMSAAOnCPUDevices,
+           "disable-msaa-on-cpu-devices",
+           "Render offscreen passes without MSAA when Impeller uses a CPU "
+           "implementation of Vulkan, such as SwiftShader.")
 DEF_SWITCHES_END
 
 void PrintUsage(const std::string& executable_name);
@@ -105,6 +105,69 @@ TEST(SwitchesTest, NoEnableImpeller) {
   }
 }
 
+TEST(SwitchesTest, DecodedImageCacheMaxBytes) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--decoded-image-cache-max-bytes=1024"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.decoded_image_cache_max_bytes, 1024u);
+  }
+  {
+    // disable
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--decoded-image-cache-max-bytes=0"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.decoded_image_cache_max_bytes, 0u);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_FALSE(settings.decoded_image_cache_max_bytes.has_value());
+  }
+}
+
+TEST(SwitchesTest, ScreenshotPngZLibLevel) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--screenshot-png-zlib-level=1"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.screenshot_png_zlib_level, 1);
+  }
+  {
+    // out of range
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--screenshot-png-zlib-level=12"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.screenshot_png_zlib_level, 9);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.screenshot_png_zlib_level, 6);
+  }
+}
+
+TEST(SwitchesTest, DisableMSAAOnCPUDevices) {
+  {
+    // enable
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--disable-msaa-on-cpu-devices"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.disable_msaa_on_cpu_devices, true);
+  }
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.disable_msaa_on_cpu_devices, false);
+  }
+}
+
 #if !FLUTTER_RELEASE
 TEST(SwitchesTest, EnableAsserts) {
   fml::CommandLine command_line = fml::CommandLineFromInitializerList(
@@ -48,6 +48,7 @@ static std::shared_ptr<impeller::Context> CreateImpellerContext(
   settings.enable_validation = p_settings.enable_validation;
   settings.enable_gpu_tracing = p_settings.enable_gpu_tracing;
   settings.disable_surface_control = p_settings.disable_surface_control;
+  settings.disable_msaa_on_cpu_devices = p_settings.disable_msaa_on_cpu_devices;
 
   auto context = impeller::ContextVK::Create(std::move(settings));
 
@@ -26,6 +26,7 @@ class AndroidContext {
     bool enable_validation = false;
     bool enable_gpu_tracing = false;
     bool disable_surface_control = false;
+    bool disable_msaa_on_cpu_devices = false;
     bool quiet = false;
   };
 
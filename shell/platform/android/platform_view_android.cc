@@ -45,6 +45,7 @@ AndroidContext::ContextSettings CreateContextSettings(
   settings.enable_gpu_tracing = p_settings.enable_vulkan_gpu_tracing;
   settings.enable_validation = p_settings.enable_vulkan_validation;
   settings.disable_surface_control = p_settings.disable_surface_control;
+  settings.disable_msaa_on_cpu_devices = p_settings.disable_msaa_on_cpu_devices;
   return settings;
 }
 }  // namespace
@@ -49,6 +49,7 @@ extern const intptr_t kPlatformStrongDillSize;
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/lib/ui/painting/decoded_image_disk_cache.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/platform/embedder/embedder.h"
@@ -1904,6 +1905,11 @@ FlutterEngineResult FlutterEngineInitialize(size_t version,
     icu_data_path = SAFE_ACCESS(args, icu_data_path, nullptr);
   }
 
+  if (SAFE_ACCESS(args, persistent_cache_path, nullptr) != nullptr) {
+    flutter::DecodedImageDiskCache::SetCacheDirectoryPath(
+        SAFE_ACCESS(args, persistent_cache_path, nullptr));
+  }
+
 #if !SLIMPELLER
   if (SAFE_ACCESS(args, persistent_cache_path, nullptr) != nullptr) {
     std::string persistent_cache_path =
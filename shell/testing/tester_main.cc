@@ -64,15 +64,18 @@ struct ImpellerVulkanContextHolder {
   std::shared_ptr<impeller::ContextVK> context;
   std::shared_ptr<impeller::SurfaceContextVK> surface_context;
 
-  bool Initialize(bool enable_validation);
+  bool Initialize(bool enable_validation, bool disable_msaa_on_cpu_devices);
 };
 
-bool ImpellerVulkanContextHolder::Initialize(bool enable_validation) {
+bool ImpellerVulkanContextHolder::Initialize(
+    bool enable_validation,
+    bool disable_msaa_on_cpu_devices) {
   impeller::ContextVK::Settings context_settings;
   context_settings.proc_address_callback = &vkGetInstanceProcAddr;
   context_settings.shader_libraries_data = ShaderLibraryMappings();
   context_settings.cache_directory = fml::paths::GetCachesDirectory();
   context_settings.enable_validation = enable_validation;
+  context_settings.disable_msaa_on_cpu_devices = disable_msaa_on_cpu_devices;
 
   context = impeller::ContextVK::Create(std::move(context_settings));
   if (!context || !context->IsValid()) {
@@ -371,7 +374,8 @@ int RunTester(const flutter::Settings& settings,
 #if ALLOW_IMPELLER
   if (settings.enable_impeller) {
     if (!impeller_context_holder.Initialize(
-            settings.enable_vulkan_validation)) {
+            settings.enable_vulkan_validation,
+            settings.disable_msaa_on_cpu_devices)) {
       return EXIT_FAILURE;
     }
   }
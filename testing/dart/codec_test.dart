@@ -133,6 +133,19 @@ void main() {
     }
   });
 
+  test('getNextFrame fails when the codec is disposed before decoding', () async {
+    final Uint8List data = await _getSkiaResource('flutter_logo.jpg').readAsBytes();
+    final ui.Codec codec = await ui.instantiateImageCodec(data);
+    final Future<ui.FrameInfo> frameInfo = codec.getNextFrame();
+    codec.dispose();
+    try {
+      await frameInfo;
+      fail('exception not thrown');
+    } on Exception catch (e) {
+      expect(e.toString(), contains('Decode was cancelled'));
+    }
+  });
+
   test('Animated gif can reuse across multiple frames', () async {
     // Regression test for b/271947267 and https://github.com/flutter/flutter/issues/122134
 
@@ -0,0 +1,119 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+
+import 'package:path/path.dart' as path;
+import 'package:test/test.dart';
+
+void main() {
+  test('Decodes an image added in chunks', () async {
+    await _expectDecodesInChunks(_getSkiaResource('baby_tux.png'));
+  });
+
+  test('Decodes a progressive JPEG added in chunks', () async {
+    // Progressive JPEG images are decoded again from the start for each image.
+    await _expectDecodesInChunks(_getFixture('progressive.jpg'));
+  });
+
+  test('Decodes an interlaced PNG added in chunks', () async {
+    await _expectDecodesInChunks(_getFixture('interlaced.png'));
+  });
+
+  test('close fails with invalid data', () async {
+    final ui.IncrementalImageDecoder decoder = ui.IncrementalImageDecoder(
+      onImage: (ui.Image image, bool isComplete) {
+        fail('no image expected');
+      },
+    );
+    decoder.addChunk(Uint8List.fromList(<int>[1, 2, 3]));
+    try {
+      await decoder.close();
+      fail('exception not thrown');
+    } on Exception catch (e) {
+      expect(e.toString(), contains('Invalid image data'));
+    }
+  });
+
+  test('Does not call back after dispose', () async {
+    final Uint8List data = await _getSkiaResource('baby_tux.png').readAsBytes();
+    final ui.IncrementalImageDecoder decoder = ui.IncrementalImageDecoder(
+      onImage: (ui.Image image, bool isComplete) {
+        fail('no image expected');
+      },
+    );
+    decoder.addChunk(data);
+    decoder.dispose();
+    await Future<void>.delayed(const Duration(milliseconds: 100));
+  });
+}
+
+/// Adds the first half of the image in [file] to an [ui.IncrementalImageDecoder]
+/// and waits for the partial image decoded from it, then adds the rest in
+/// chunks. The last image must match the image decoded by a [ui.Codec].
+Future<void> _expectDecodesInChunks(File file) async {
+  final Uint8List data = await file.readAsBytes();
+  final ui.Codec codec = await ui.instantiateImageCodec(data);
+  final ui.Image expected = (await codec.getNextFrame()).image;
+
+  final List<bool> completions = <bool>[];
+  final Completer<void> firstImage = Completer<void>();
+  ui.Image? last;
+  final ui.IncrementalImageDecoder decoder = ui.IncrementalImageDecoder(
+    minFrameInterval: Duration.zero,
+    onImage: (ui.Image image, bool isComplete) {
+      completions.add(isComplete);
+      expect(image.width, expected.width);
+      expect(image.height, expected.height);
+      last?.dispose();
+      last = image;
+      if (!firstImage.isCompleted) {
+        firstImage.complete();
+      }
+    },
+  );
+
+  final int half = data.length ~/ 2;
+  decoder.addChunk(Uint8List.sublistView(data, 0, half));
+  await firstImage.future;
+  expect(completions, <bool>[false]);
+
+  const int chunkSize = 1024;
+  for (int offset = half; offset < data.length; offset += chunkSize) {
+    final int end = offset + chunkSize < data.length ? offset + chunkSize : data.length;
+    decoder.addChunk(Uint8List.sublistView(data, offset, end));
+    await Future<void>.delayed(Duration.zero);
+  }
+  await decoder.close();
+
+  // Partial images arrive before the complete image, which arrives last.
+  expect(completions.first, isFalse);
+  expect(completions.last, isTrue);
+  expect(completions.where((bool isComplete) => isComplete), hasLength(1));
+
+  final ByteData expectedBytes = (await expected.toByteData())!;
+  final ByteData actualBytes = (await last!.toByteData())!;
+  expect(actualBytes.buffer.asUint8List(), expectedBytes.buffer.asUint8List());
+}
+
+/// Returns a File handle to a file in the lib/ui/fixtures directory.
+File _getFixture(String fileName) {
+  return File(path.join('flutter', 'lib', 'ui', 'fixtures', fileName));
+}
+
+/// Returns a File handle to a file in the skia/resources directory.
+File _getSkiaResource(String fileName) {
+  // As Platform.script is not working for flutter_tester
+  // (https://github.com/flutter/flutter/issues/12847), this is currently
+  // assuming the curent working directory is engine/src.
+  // This is fragile and should be changed once the Platform.script issue is
+  // resolved.
+  final String assetPath = path.join(
+    'flutter', 'third_party', 'skia', 'resources', 'images', fileName,
+  );
+  return File(assetPath);
+}